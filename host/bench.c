@@ -0,0 +1,276 @@
+#include <pebble.h>
+#include "model.h"
+#include "dictionary.h"
+#include "candidate_tracker.h"
+#include "hint_engine.h"
+
+// Microbenchmarks for the model layer. Each case reports wall time per call and the
+// resource reads per call, which are what actually cost time on a watch.
+
+#define RANDOM_WORDS 100000
+#define SCORE_GUESSES 500
+#define DAY_CALLS 100000
+#define TRACKER_GAMES 200
+#define HINT_GAMES 20
+
+typedef struct {
+	char (*words)[WORD_LENGTH];
+	int count;
+} WordList;
+
+static volatile int s_sink;
+
+static WordList prv_read_words(const char *name) {
+	char path[512];
+	snprintf(path, sizeof(path), "%s/%s", RESOURCES_DIR, name);
+	FILE *f = fopen(path, "rb");
+	if (f == NULL) {
+		fprintf(stderr, "Couldn't open %s\n", path);
+		exit(1);
+	}
+	fseek(f, 0, SEEK_END);
+	WordList list = {.count = ftell(f) / WORD_LENGTH};
+	fseek(f, 0, SEEK_SET);
+	list.words = malloc(list.count * WORD_LENGTH);
+	if (fread(list.words, WORD_LENGTH, list.count, f) != (size_t)list.count) {
+		fprintf(stderr, "Short read from %s\n", path);
+		exit(1);
+	}
+	fclose(f);
+	return list;
+}
+
+static double prv_now() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static void prv_report(const char *name, int calls, double started) {
+	double elapsed = prv_now() - started;
+	HostResourceStats stats = host_resource_stats();
+	printf("%-28s %9d calls %9.1f ns/call %7.2f reads/call %8.1f bytes/call\n",
+	       name, calls, elapsed * 1e9 / calls, (double)stats.reads / calls, (double)stats.bytes / calls);
+}
+
+static void prv_start(double *started) {
+	host_resource_stats_reset();
+	*started = prv_now();
+}
+
+static void prv_bench_valid_words(WordList *acceptable) {
+	double started;
+	int found = 0;
+	prv_start(&started);
+	for (int i = 0; i < acceptable->count; ++i) {
+		found += is_valid_word(acceptable->words[i]);
+	}
+	prv_report("is_valid_word (accepted)", acceptable->count, started);
+	if (found != acceptable->count) {
+		printf("  !! only %d of %d accepted words were found\n", found, acceptable->count);
+	}
+}
+
+static void prv_bench_random_words() {
+	char (*words)[WORD_LENGTH] = malloc(RANDOM_WORDS * WORD_LENGTH);
+	srand(1);
+	for (int i = 0; i < RANDOM_WORDS; ++i) {
+		for (int j = 0; j < WORD_LENGTH; ++j) {
+			words[i][j] = 'a' + rand() % 26;
+		}
+	}
+	double started;
+	int found = 0;
+	prv_start(&started);
+	for (int i = 0; i < RANDOM_WORDS; ++i) {
+		found += is_valid_word(words[i]);
+	}
+	prv_report("is_valid_word (random)", RANDOM_WORDS, started);
+	s_sink = found;
+	free(words);
+}
+
+// Every prefix of every accepted word, as the cursor reaches each tile while typing it.
+static void prv_bench_next_letters(WordList *acceptable) {
+	uint16_t counts[26];
+	int missing = 0;
+	double started;
+	prv_start(&started);
+	for (int i = 0; i < acceptable->count; ++i) {
+		for (int length = 0; length < WORD_LENGTH; ++length) {
+			dictionary_count_next_letters(acceptable->words[i], length, counts);
+			missing += counts[acceptable->words[i][length] - 'a'] == 0;
+		}
+	}
+	prv_report("dictionary_count_next_letters", acceptable->count * WORD_LENGTH, started);
+	if (missing > 0) {
+		printf("  !! %d prefixes of accepted words had their next letter missing\n", missing);
+	}
+}
+
+static void prv_bench_score_word(WordList *acceptable, WordList *solutions) {
+	LetterStatus result[WORD_LENGTH];
+	int stride = acceptable->count / SCORE_GUESSES;
+	int calls = 0;
+	int correct = 0;
+	double started;
+	prv_start(&started);
+	for (int i = 0; i < SCORE_GUESSES; ++i) {
+		for (int j = 0; j < solutions->count; ++j) {
+			correct += score_word(acceptable->words[i * stride], solutions->words[j], result);
+			++calls;
+		}
+	}
+	prv_report("score_word", calls, started);
+	s_sink = correct + result[0];
+}
+
+static void prv_bench_score_word_packed(WordList *acceptable, WordList *solutions) {
+	int stride = acceptable->count / SCORE_GUESSES;
+	int calls = 0;
+	int total = 0;
+	double started;
+	prv_start(&started);
+	for (int i = 0; i < SCORE_GUESSES; ++i) {
+		for (int j = 0; j < solutions->count; ++j) {
+			total += score_word_packed(acceptable->words[i * stride], solutions->words[j]);
+			++calls;
+		}
+	}
+	prv_report("score_word_packed", calls, started);
+	s_sink = total;
+}
+
+static void prv_bench_score_packed(WordList *acceptable, WordList *solutions) {
+	PackedWord *packed = malloc(solutions->count * sizeof(PackedWord));
+	for (int j = 0; j < solutions->count; ++j) {
+		packed[j] = word_pack(solutions->words[j]);
+	}
+	int stride = acceptable->count / SCORE_GUESSES;
+	int calls = 0;
+	int total = 0;
+	double started;
+	prv_start(&started);
+	for (int i = 0; i < SCORE_GUESSES; ++i) {
+		PackedWord guess = word_pack(acceptable->words[i * stride]);
+		for (int j = 0; j < solutions->count; ++j) {
+			total += score_packed(guess, packed[j]);
+			++calls;
+		}
+	}
+	prv_report("score_packed", calls, started);
+
+	uint8_t *patterns = malloc(solutions->count);
+	calls = 0;
+	prv_start(&started);
+	for (int i = 0; i < SCORE_GUESSES; ++i) {
+		score_packed_many(word_pack(acceptable->words[i * stride]), packed, solutions->count, patterns);
+		calls += solutions->count;
+		total += patterns[i];
+	}
+	prv_report("score_packed_many", calls, started);
+	s_sink = total;
+	free(patterns);
+	free(packed);
+}
+
+// Plays the same two opening guesses against a spread of answers, as the game would after
+// each of the first two guesses.
+static void prv_bench_candidate_tracker(WordList *solutions) {
+	char openers[2][WORD_LENGTH] = {{'r', 'a', 'i', 's', 'e'}, {'c', 'l', 'o', 'u', 't'}};
+	int stride = solutions->count / TRACKER_GAMES;
+	int remaining = 0;
+	double started;
+	prv_start(&started);
+	for (int i = 0; i < TRACKER_GAMES; ++i) {
+		char *answer = solutions->words[i * stride];
+		CandidateTracker *tracker = candidate_tracker_create();
+		for (int j = 0; j < 2; ++j) {
+			candidate_tracker_apply_guess(tracker, openers[j], score_word_packed(openers[j], answer));
+		}
+		remaining += candidate_tracker_get_count(tracker);
+		candidate_tracker_destroy(tracker);
+	}
+	prv_report("candidate_tracker (2 guesses)", TRACKER_GAMES, started);
+	printf("  %.1f solutions left on average\n", (double)remaining / TRACKER_GAMES);
+}
+
+static void prv_hint_done(char word[WORD_LENGTH], void *context) {
+	memcpy(context, word, WORD_LENGTH);
+}
+
+// Asks for a hint after the first guess, then plays it, over a spread of answers. The host
+// doesn't wait out the gaps between scheduler slices, so this is just the compute time.
+static void prv_bench_hint_engine(WordList *solutions) {
+	char opener[WORD_LENGTH] = {'r', 'a', 'i', 's', 'e'};
+	int stride = solutions->count / HINT_GAMES;
+	int slices = 0;
+	int before = 0;
+	int after = 0;
+	double started;
+	prv_start(&started);
+	for (int i = 0; i < HINT_GAMES; ++i) {
+		char *answer = solutions->words[i * stride];
+		CandidateTracker *tracker = candidate_tracker_create();
+		candidate_tracker_apply_guess(tracker, opener, score_word_packed(opener, answer));
+		before += candidate_tracker_get_count(tracker);
+		char hint[WORD_LENGTH];
+		HintEngine *engine = hint_engine_start(tracker, (HintEngineHandlers) {.done = prv_hint_done}, hint);
+		slices += host_run_timers();
+		hint_engine_destroy(engine);
+		candidate_tracker_apply_guess(tracker, hint, score_word_packed(hint, answer));
+		after += candidate_tracker_get_count(tracker);
+		candidate_tracker_destroy(tracker);
+	}
+	prv_report("hint_engine (after 1 guess)", HINT_GAMES, started);
+	printf("  %.1f scheduler slices per hint, %.1f -> %.1f solutions left on average\n",
+	       (double)slices / HINT_GAMES, (double)before / HINT_GAMES, (double)after / HINT_GAMES);
+}
+
+static void prv_bench_word_of_the_day() {
+	char word[WORD_LENGTH];
+	double started;
+	prv_start(&started);
+	for (int i = 0; i < DAY_CALLS; ++i) {
+		word_of_the_day(word);
+	}
+	prv_report("word_of_the_day", DAY_CALLS, started);
+	s_sink = word[0];
+}
+
+static void prv_bench_wordle_number() {
+	int total = 0;
+	double started;
+	prv_start(&started);
+	for (int i = 0; i < DAY_CALLS; ++i) {
+		total += wordle_number();
+	}
+	prv_report("wordle_number", DAY_CALLS, started);
+	s_sink = total;
+}
+
+int main() {
+	WordList acceptable = prv_read_words("acceptable.dat");
+	WordList solutions = prv_read_words("solutions.dat");
+
+	double started;
+	prv_start(&started);
+	dictionary_init();
+	prv_report("dictionary_init", 1, started);
+
+	prv_bench_valid_words(&acceptable);
+	prv_bench_random_words();
+	prv_bench_next_letters(&acceptable);
+	prv_bench_score_word(&acceptable, &solutions);
+	prv_bench_score_word_packed(&acceptable, &solutions);
+	prv_bench_score_packed(&acceptable, &solutions);
+	prv_bench_candidate_tracker(&solutions);
+	prv_bench_hint_engine(&solutions);
+	prv_bench_word_of_the_day();
+	prv_bench_wordle_number();
+
+	dictionary_deinit();
+	free(acceptable.words);
+	free(solutions.words);
+	return 0;
+}
@@ -0,0 +1,67 @@
+"""
+Prepares resources for the host build: runs the same generators the wscript does, with the
+same per-platform settings, then writes the resource ID header and path table that the
+pebble.h shim uses in place of the SDK's generated ones.
+
+Usage: python3 host/generate_resources.py <platform> <out_dir>
+"""
+import json
+import os
+import runpy
+import sys
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), '..'))
+RESOURCES = os.path.join(ROOT, 'resources')
+
+sys.path.insert(0, os.path.join(ROOT, 'tools'))
+import generate_resources as generator  # noqa: E402
+
+
+def _write_if_changed(path, text):
+    try:
+        with open(path) as f:
+            if f.read() == text:
+                return
+    except IOError:
+        pass
+    with open(path, 'w') as f:
+        f.write(text)
+
+
+def _platform_file(name, platform):
+    # The SDK prefers file~platform.ext over file.ext when it exists.
+    base, ext = os.path.splitext(name)
+    tagged = os.path.join(RESOURCES, '{}~{}{}'.format(base, platform, ext))
+    if os.path.exists(tagged):
+        return tagged
+    return os.path.join(RESOURCES, name)
+
+
+def main(platform, out_dir):
+    settings = runpy.run_path(os.path.join(ROOT, 'wscript'))
+    generator.generate(RESOURCES, bloom_filter=settings['BLOOM_FILTER'],
+                       dictionary_backend=settings['DICTIONARY_BACKEND'],
+                       solution_index_enabled=settings['SOLUTION_INDEX'])
+
+    with open(os.path.join(ROOT, 'package.json')) as f:
+        media = json.load(f)['pebble']['resources']['media']
+
+    header = ['#pragma once', '', '// Generated by host/generate_resources.py for {}.'.format(platform), '',
+              'enum {']
+    paths = ['#include "resource_ids.auto.h"', '',
+             'const char *const RESOURCE_PATHS[RESOURCE_COUNT] = {']
+    for i, resource in enumerate(media):
+        header.append('\tRESOURCE_ID_{} = {},'.format(resource['name'], i + 1))
+        paths.append('\t{},'.format(json.dumps(_platform_file(resource['file'], platform))))
+    header += ['};', '', '#define RESOURCE_COUNT {}'.format(len(media)), '',
+               'extern const char *const RESOURCE_PATHS[RESOURCE_COUNT];', '']
+    paths += ['};', '']
+
+    if not os.path.isdir(out_dir):
+        os.makedirs(out_dir)
+    _write_if_changed(os.path.join(out_dir, 'resource_ids.auto.h'), '\n'.join(header))
+    _write_if_changed(os.path.join(out_dir, 'resource_paths.auto.c'), '\n'.join(paths))
+
+
+if __name__ == '__main__':
+    main(sys.argv[1], sys.argv[2])
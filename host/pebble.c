@@ -0,0 +1,237 @@
+#include <pebble.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define PERSIST_KEY_LIMIT 64
+#define TIMER_LIMIT 16
+
+typedef struct {
+	const uint8_t *data;
+	size_t size;
+} HostResource;
+
+typedef struct {
+	bool used;
+	uint32_t key;
+	int size;
+	uint8_t data[PERSIST_DATA_MAX_LENGTH];
+} HostPersistEntry;
+
+static HostResource s_resources[RESOURCE_COUNT];
+static HostResourceStats s_stats;
+static HostPersistEntry s_persist[PERSIST_KEY_LIMIT];
+
+struct AppTimer {
+	bool used;
+	uint64_t due;
+	uint64_t sequence;
+	AppTimerCallback callback;
+	void *data;
+};
+
+static AppTimer s_timers[TIMER_LIMIT];
+static uint64_t s_timer_clock;
+static uint64_t s_timer_sequence;
+
+void app_log(uint8_t log_level, const char *src_filename, int src_line_number, const char *fmt, ...) {
+	va_list args;
+	va_start(args, fmt);
+	fprintf(stderr, "[%d] %s:%d> ", log_level, src_filename, src_line_number);
+	vfprintf(stderr, fmt, args);
+	fputc('\n', stderr);
+	va_end(args);
+}
+
+ResHandle resource_get_handle(uint32_t resource_id) {
+	if (resource_id == 0 || resource_id > RESOURCE_COUNT) {
+		return NULL;
+	}
+	HostResource *resource = &s_resources[resource_id - 1];
+	if (resource->data != NULL) {
+		return resource;
+	}
+	const char *path = RESOURCE_PATHS[resource_id - 1];
+	int fd = open(path, O_RDONLY);
+	struct stat info;
+	if (fd < 0 || fstat(fd, &info) != 0) {
+		fprintf(stderr, "Couldn't open resource %s\n", path);
+		abort();
+	}
+	resource->size = info.st_size;
+	// mmap refuses empty mappings; any non-NULL pointer will do for those.
+	resource->data = resource->size == 0 ? (const uint8_t *)"" : mmap(NULL, resource->size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (resource->data == MAP_FAILED) {
+		fprintf(stderr, "Couldn't map resource %s\n", path);
+		abort();
+	}
+	return resource;
+}
+
+size_t resource_size(ResHandle h) {
+	return ((const HostResource *)h)->size;
+}
+
+size_t resource_load_byte_range(ResHandle h, uint32_t start_offset, uint8_t *buffer, size_t num_bytes) {
+	const HostResource *resource = h;
+	++s_stats.reads;
+	if (start_offset >= resource->size) {
+		return 0;
+	}
+	if (num_bytes > resource->size - start_offset) {
+		num_bytes = resource->size - start_offset;
+	}
+	memcpy(buffer, resource->data + start_offset, num_bytes);
+	s_stats.bytes += num_bytes;
+	return num_bytes;
+}
+
+size_t resource_load(ResHandle h, uint8_t *buffer, size_t max_length) {
+	return resource_load_byte_range(h, 0, buffer, max_length);
+}
+
+static HostPersistEntry *prv_persist_find(uint32_t key, bool create) {
+	HostPersistEntry *free_entry = NULL;
+	for (int i = 0; i < PERSIST_KEY_LIMIT; ++i) {
+		if (s_persist[i].used && s_persist[i].key == key) {
+			return &s_persist[i];
+		}
+		if (!s_persist[i].used && free_entry == NULL) {
+			free_entry = &s_persist[i];
+		}
+	}
+	if (!create || free_entry == NULL) {
+		return NULL;
+	}
+	free_entry->used = true;
+	free_entry->key = key;
+	free_entry->size = 0;
+	return free_entry;
+}
+
+bool persist_exists(const uint32_t key) {
+	return prv_persist_find(key, false) != NULL;
+}
+
+int persist_get_size(const uint32_t key) {
+	HostPersistEntry *entry = prv_persist_find(key, false);
+	return entry == NULL ? E_DOES_NOT_EXIST : entry->size;
+}
+
+int32_t persist_read_int(const uint32_t key) {
+	int32_t value = 0;
+	persist_read_data(key, &value, sizeof(value));
+	return value;
+}
+
+bool persist_read_bool(const uint32_t key) {
+	return persist_read_int(key) != 0;
+}
+
+int persist_read_data(const uint32_t key, void *buffer, const size_t buffer_size) {
+	HostPersistEntry *entry = prv_persist_find(key, false);
+	if (entry == NULL) {
+		return E_DOES_NOT_EXIST;
+	}
+	size_t size = (size_t)entry->size < buffer_size ? (size_t)entry->size : buffer_size;
+	memcpy(buffer, entry->data, size);
+	return size;
+}
+
+status_t persist_write_int(const uint32_t key, const int32_t value) {
+	int written = persist_write_data(key, &value, sizeof(value));
+	return written < 0 ? written : S_SUCCESS;
+}
+
+status_t persist_write_bool(const uint32_t key, const bool value) {
+	return persist_write_int(key, value);
+}
+
+int persist_write_data(const uint32_t key, const void *data, const size_t size) {
+	if (size > PERSIST_DATA_MAX_LENGTH) {
+		return E_INVALID_ARGUMENT;
+	}
+	HostPersistEntry *entry = prv_persist_find(key, true);
+	if (entry == NULL) {
+		fprintf(stderr, "Out of host persist slots\n");
+		abort();
+	}
+	memcpy(entry->data, data, size);
+	entry->size = size;
+	return size;
+}
+
+status_t persist_delete(const uint32_t key) {
+	HostPersistEntry *entry = prv_persist_find(key, false);
+	if (entry == NULL) {
+		return E_DOES_NOT_EXIST;
+	}
+	entry->used = false;
+	return S_SUCCESS;
+}
+
+uint16_t time_ms(time_t *tloc, uint16_t *out_ms) {
+	struct timespec now;
+	clock_gettime(CLOCK_REALTIME, &now);
+	uint16_t ms = now.tv_nsec / 1000000;
+	if (tloc != NULL) {
+		*tloc = now.tv_sec;
+	}
+	if (out_ms != NULL) {
+		*out_ms = ms;
+	}
+	return ms;
+}
+
+AppTimer *app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void *callback_data) {
+	for (int i = 0; i < TIMER_LIMIT; ++i) {
+		if (!s_timers[i].used) {
+			s_timers[i] = (AppTimer) {
+				.used = true,
+				.due = s_timer_clock + timeout_ms,
+				.sequence = s_timer_sequence++,
+				.callback = callback,
+				.data = callback_data,
+			};
+			return &s_timers[i];
+		}
+	}
+	fprintf(stderr, "Out of host timers\n");
+	abort();
+}
+
+void app_timer_cancel(AppTimer *timer_handle) {
+	timer_handle->used = false;
+}
+
+int host_run_timers() {
+	int fired = 0;
+	for (;;) {
+		AppTimer *next = NULL;
+		for (int i = 0; i < TIMER_LIMIT; ++i) {
+			AppTimer *timer = &s_timers[i];
+			if (timer->used && (next == NULL || timer->due < next->due ||
+			                    (timer->due == next->due && timer->sequence < next->sequence))) {
+				next = timer;
+			}
+		}
+		if (next == NULL) {
+			return fired;
+		}
+		next->used = false;
+		s_timer_clock = next->due;
+		next->callback(next->data);
+		++fired;
+	}
+}
+
+HostResourceStats host_resource_stats() {
+	return s_stats;
+}
+
+void host_resource_stats_reset() {
+	s_stats = (HostResourceStats) {0};
+}
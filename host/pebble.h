@@ -0,0 +1,74 @@
+#ifndef HOST_PEBBLE_H
+#define HOST_PEBBLE_H
+
+// Just enough of the Pebble SDK to build the model layer on a desktop. Resources are
+// memory-mapped from resources/, picking the same ~platform variants the SDK would, and
+// persistent storage lives in memory for the life of the process.
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "resource_ids.auto.h"
+
+typedef const void *ResHandle;
+typedef int32_t status_t;
+
+#define S_SUCCESS 0
+#define E_INVALID_ARGUMENT -4
+#define E_DOES_NOT_EXIST -9
+
+#define PERSIST_DATA_MAX_LENGTH 256
+
+typedef enum {
+	APP_LOG_LEVEL_ERROR = 1,
+	APP_LOG_LEVEL_WARNING = 50,
+	APP_LOG_LEVEL_INFO = 100,
+	APP_LOG_LEVEL_DEBUG = 200,
+	APP_LOG_LEVEL_DEBUG_VERBOSE = 255,
+} AppLogLevel;
+
+#define APP_LOG(level, fmt, ...) app_log(level, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
+void app_log(uint8_t log_level, const char *src_filename, int src_line_number, const char *fmt, ...);
+
+ResHandle resource_get_handle(uint32_t resource_id);
+size_t resource_size(ResHandle h);
+size_t resource_load_byte_range(ResHandle h, uint32_t start_offset, uint8_t *buffer, size_t num_bytes);
+size_t resource_load(ResHandle h, uint8_t *buffer, size_t max_length);
+
+bool persist_exists(const uint32_t key);
+int persist_get_size(const uint32_t key);
+int32_t persist_read_int(const uint32_t key);
+bool persist_read_bool(const uint32_t key);
+int persist_read_data(const uint32_t key, void *buffer, const size_t buffer_size);
+status_t persist_write_int(const uint32_t key, const int32_t value);
+status_t persist_write_bool(const uint32_t key, const bool value);
+int persist_write_data(const uint32_t key, const void *data, const size_t size);
+status_t persist_delete(const uint32_t key);
+
+uint16_t time_ms(time_t *tloc, uint16_t *out_ms);
+
+typedef struct AppTimer AppTimer;
+typedef void (*AppTimerCallback)(void *data);
+AppTimer *app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void *callback_data);
+void app_timer_cancel(AppTimer *timer_handle);
+
+// Host-only: counters for everything that would have hit flash on a watch.
+typedef struct {
+	uint32_t reads;
+	uint32_t bytes;
+} HostResourceStats;
+
+HostResourceStats host_resource_stats();
+void host_resource_stats_reset();
+
+// Host-only: stands in for the event loop, firing timers in due order (without actually
+// waiting) until none are left. Returns how many fired.
+int host_run_timers();
+
+#endif
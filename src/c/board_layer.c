@@ -0,0 +1,296 @@
+#include <pebble.h>
+#include "board_layer.h"
+#include "model.h"
+#include "tile.h"
+#include "flip_animation.h"
+
+// The whole grid of tiles as one layer, drawn in a single pass: the frame buffer is captured
+// once for every checkerboard fill, then the tiles and the cursor are drawn over it.
+//
+// With BOARD_ROW_CACHE (set per platform in the wscript), a row that's been scored and has
+// finished flipping is copied out of the frame buffer the first time it's drawn, and blitted
+// from that copy from then on, since it won't change again. The copies go with the layer.
+
+typedef struct {
+	char letter;
+	LetterStatus status;
+	bool confirmed;
+	// How tall the tile is drawn, which is less than TILE_SIZE while it's flipping.
+	uint8_t height;
+} BoardTile;
+
+typedef struct {
+	int rows;
+	int cursor_row;
+	int cursor_index;
+	FlipAnimation flip;
+	int flip_row;
+	LetterStatus flip_statuses[WORD_LENGTH];
+#ifdef BOARD_ROW_CACHE
+	GBitmap *row_cache[BOARD_MAX_ROWS];
+#endif
+	BoardTile tiles[];
+} BoardLayerData;
+
+static void prv_update_proc(Layer *layer, GContext *ctx);
+static void prv_fill_checkerboards(Layer *layer, GContext *ctx);
+static GRect prv_tile_rect(BoardLayerData *data, int row, int index);
+static void prv_set_tile(BoardLayer *layer, int row, int index, char letter, LetterStatus status, bool confirmed, uint8_t height);
+static void prv_flip_update(int tile, int height, bool turned, void *context);
+#ifdef BOARD_ROW_CACHE
+static bool prv_row_is_final(BoardLayerData *data, int row);
+static void prv_cache_rows(Layer *layer, GContext *ctx);
+static void prv_copy_bits(uint8_t *dest, int dest_x, const uint8_t *src, int src_x, int count);
+static void prv_drop_row_cache(BoardLayerData *data, int row);
+
+static int s_cache_bytes;
+#endif
+
+BoardLayer *board_layer_create(GPoint where, int rows) {
+	if (rows > BOARD_MAX_ROWS) {
+		rows = BOARD_MAX_ROWS;
+	}
+	GRect frame = GRect(where.x, where.y, BOARD_LAYER_WIDTH, TILE_PITCH * rows - 1);
+	Layer *layer = layer_create_with_data(frame, sizeof(BoardLayerData) + rows * WORD_LENGTH * sizeof(BoardTile));
+	BoardLayerData *data = layer_get_data(layer);
+	data->rows = rows;
+	data->cursor_row = -1;
+	data->cursor_index = -1;
+	data->flip = (FlipAnimation) {0};
+#ifdef BOARD_ROW_CACHE
+	memset(data->row_cache, 0, sizeof(data->row_cache));
+#endif
+	for (int i = 0; i < rows * WORD_LENGTH; ++i) {
+		data->tiles[i] = (BoardTile) {
+			.letter = 0,
+			.status = LetterStatusNeutral,
+			.confirmed = false,
+			.height = TILE_SIZE,
+		};
+	}
+	layer_set_update_proc(layer, prv_update_proc);
+	return layer;
+}
+
+void board_layer_destroy(BoardLayer *layer) {
+	BoardLayerData *data = layer_get_data(layer);
+	flip_animation_stop(&data->flip);
+#ifdef BOARD_ROW_CACHE
+	for (int row = 0; row < data->rows; ++row) {
+		prv_drop_row_cache(data, row);
+	}
+#endif
+	layer_destroy(layer);
+}
+
+void board_layer_set_letter(BoardLayer *layer, int row, int index, char letter, LetterStatus status, bool confirmed) {
+	prv_set_tile(layer, row, index, letter, status, confirmed, TILE_SIZE);
+}
+
+void board_layer_set_cursor(BoardLayer *layer, int row, int index) {
+	BoardLayerData *data = layer_get_data(layer);
+	if (index < 0) {
+		row = -1;
+	}
+	if (data->cursor_row == row && data->cursor_index == index) {
+		return;
+	}
+	data->cursor_row = row;
+	data->cursor_index = index;
+	layer_mark_dirty(layer);
+}
+
+void board_layer_apply_score(BoardLayer *layer, int row, LetterStatus statuses[WORD_LENGTH], bool animated) {
+	BoardLayerData *data = layer_get_data(layer);
+	// Only one row flips at a time; an earlier one is finished off first.
+	flip_animation_stop(&data->flip);
+	if (!animated) {
+		for (int i = 0; i < WORD_LENGTH; ++i) {
+			BoardTile *tile = &data->tiles[row * WORD_LENGTH + i];
+			prv_set_tile(layer, row, i, tile->letter, statuses[i], true, TILE_SIZE);
+		}
+		return;
+	}
+	data->flip_row = row;
+	memcpy(data->flip_statuses, statuses, sizeof(data->flip_statuses));
+	flip_animation_start(&data->flip, WORD_LENGTH, FLIP_DURATION, prv_flip_update, layer);
+}
+
+static void prv_update_proc(Layer *layer, GContext *ctx) {
+	BoardLayerData *data = layer_get_data(layer);
+	// The game board is big enough to lay out the tile glyphs the first time it's drawn.
+	if (!tile_glyphs_ready()) {
+		tile_prepare_glyphs(layer, ctx);
+	}
+	prv_fill_checkerboards(layer, ctx);
+	for (int row = 0; row < data->rows; ++row) {
+#ifdef BOARD_ROW_CACHE
+		if (data->row_cache[row] != NULL) {
+			graphics_draw_bitmap_in_rect(ctx, data->row_cache[row], GRect(0, row * TILE_PITCH, BOARD_LAYER_WIDTH, TILE_PITCH - 1));
+			continue;
+		}
+#endif
+		for (int i = 0; i < WORD_LENGTH; ++i) {
+			BoardTile *tile = &data->tiles[row * WORD_LENGTH + i];
+			tile_draw(ctx, prv_tile_rect(data, row, i), tile->letter, tile->status, tile->confirmed);
+		}
+	}
+	if (data->cursor_row >= 0) {
+		graphics_context_set_stroke_color(ctx, GColorBlack);
+		graphics_draw_rect(ctx, GRect(data->cursor_index * TILE_PITCH, data->cursor_row * TILE_PITCH, TILE_SIZE + 2, TILE_SIZE + 2));
+	}
+#ifdef BOARD_ROW_CACHE
+	prv_cache_rows(layer, ctx);
+#endif
+}
+
+static void prv_fill_checkerboards(Layer *layer, GContext *ctx) {
+	BoardLayerData *data = layer_get_data(layer);
+	GBitmap *fb_bitmap = NULL;
+	GPoint origin = layer_convert_rect_to_screen(layer, GRect(0, 0, 0, 0)).origin;
+	for (int row = 0; row < data->rows; ++row) {
+		for (int i = 0; i < WORD_LENGTH; ++i) {
+			BoardTile *tile = &data->tiles[row * WORD_LENGTH + i];
+			if (!tile_has_checkerboard(tile->confirmed)) {
+				continue;
+			}
+			if (fb_bitmap == NULL) {
+				fb_bitmap = graphics_capture_frame_buffer(ctx);
+				if (fb_bitmap == NULL) {
+					return;
+				}
+			}
+			GRect rect = prv_tile_rect(data, row, i);
+			rect.origin.x += origin.x;
+			rect.origin.y += origin.y;
+			tile_draw_checkerboard(fb_bitmap, rect, tile->status);
+		}
+	}
+	if (fb_bitmap != NULL) {
+		graphics_release_frame_buffer(ctx, fb_bitmap);
+	}
+}
+
+static GRect prv_tile_rect(BoardLayerData *data, int row, int index) {
+	int height = data->tiles[row * WORD_LENGTH + index].height;
+	return GRect(1 + index * TILE_PITCH, 1 + row * TILE_PITCH + (TILE_SIZE - height) / 2, TILE_SIZE, height);
+}
+
+// Setting a tile to what it already shows doesn't cause a redraw.
+static void prv_set_tile(BoardLayer *layer, int row, int index, char letter, LetterStatus status, bool confirmed, uint8_t height) {
+	BoardLayerData *data = layer_get_data(layer);
+	BoardTile *tile = &data->tiles[row * WORD_LENGTH + index];
+	if (tile->letter == letter && tile->status == status && tile->confirmed == confirmed && tile->height == height) {
+		return;
+	}
+	*tile = (BoardTile) {
+		.letter = letter,
+		.status = status,
+		.confirmed = confirmed,
+		.height = height,
+	};
+#ifdef BOARD_ROW_CACHE
+	prv_drop_row_cache(data, row);
+#endif
+	layer_mark_dirty(layer);
+}
+
+// Each tile takes its score as it turns over.
+static void prv_flip_update(int tile, int height, bool turned, void *context) {
+	BoardLayer *layer = context;
+	BoardLayerData *data = layer_get_data(layer);
+	BoardTile *board_tile = &data->tiles[data->flip_row * WORD_LENGTH + tile];
+	if (turned) {
+		prv_set_tile(layer, data->flip_row, tile, board_tile->letter, data->flip_statuses[tile], true, height);
+	} else {
+		prv_set_tile(layer, data->flip_row, tile, board_tile->letter, board_tile->status, board_tile->confirmed, height);
+	}
+}
+
+#ifdef BOARD_ROW_CACHE
+// Whether a row will look the same from now on: scored, done flipping, and without the cursor.
+static bool prv_row_is_final(BoardLayerData *data, int row) {
+	if (data->cursor_row == row || (data->flip.animation != NULL && data->flip_row == row)) {
+		return false;
+	}
+	for (int i = 0; i < WORD_LENGTH; ++i) {
+		BoardTile *tile = &data->tiles[row * WORD_LENGTH + i];
+		if (!tile->confirmed || tile->letter == 0 || tile->height != TILE_SIZE) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Copies the rows that have just become final out of the frame buffer, once they've been drawn
+// into it. A row that isn't entirely on screen, as in a scrolled help window, is left to be
+// drawn as usual.
+static void prv_cache_rows(Layer *layer, GContext *ctx) {
+	BoardLayerData *data = layer_get_data(layer);
+	GBitmap *fb_bitmap = NULL;
+	GPoint origin = layer_convert_rect_to_screen(layer, GRect(0, 0, 0, 0)).origin;
+	for (int row = 0; row < data->rows; ++row) {
+		if (data->row_cache[row] != NULL || !prv_row_is_final(data, row)) {
+			continue;
+		}
+		if (fb_bitmap == NULL) {
+			fb_bitmap = graphics_capture_frame_buffer(ctx);
+			if (fb_bitmap == NULL) {
+				return;
+			}
+		}
+		GRect rect = GRect(origin.x, origin.y + row * TILE_PITCH, BOARD_LAYER_WIDTH, TILE_PITCH - 1);
+		GRect screen = gbitmap_get_bounds(fb_bitmap);
+		if (!grect_contains_point(&screen, &rect.origin) ||
+				rect.origin.x + rect.size.w > screen.origin.x + screen.size.w ||
+				rect.origin.y + rect.size.h > screen.origin.y + screen.size.h) {
+			continue;
+		}
+		GBitmapFormat format = gbitmap_get_format(fb_bitmap);
+		GBitmap *cache = gbitmap_create_blank(rect.size, format);
+		if (cache == NULL) {
+			continue;
+		}
+		uint8_t *src = gbitmap_get_data(fb_bitmap);
+		int src_stride = gbitmap_get_bytes_per_row(fb_bitmap);
+		uint8_t *dest = gbitmap_get_data(cache);
+		int dest_stride = gbitmap_get_bytes_per_row(cache);
+		for (int y = 0; y < rect.size.h; ++y) {
+			uint8_t *src_row = src + (rect.origin.y + y) * src_stride;
+			if (format == GBitmapFormat1Bit) {
+				prv_copy_bits(dest + y * dest_stride, 0, src_row, rect.origin.x, rect.size.w);
+			} else {
+				memcpy(dest + y * dest_stride, src_row + rect.origin.x, rect.size.w);
+			}
+		}
+		data->row_cache[row] = cache;
+		s_cache_bytes += dest_stride * rect.size.h;
+		APP_LOG(APP_LOG_LEVEL_DEBUG, "Cached board row %d; row caches hold %d bytes.", row, s_cache_bytes);
+	}
+	if (fb_bitmap != NULL) {
+		graphics_release_frame_buffer(ctx, fb_bitmap);
+	}
+}
+
+// Copies count pixels of a 1-bit row, leftmost pixel in the lowest bit of each byte.
+static void prv_copy_bits(uint8_t *dest, int dest_x, const uint8_t *src, int src_x, int count) {
+	for (int i = 0; i < count; ++i) {
+		int from = src_x + i;
+		int to = dest_x + i;
+		if (src[from >> 3] & (1 << (from & 7))) {
+			dest[to >> 3] |= 1 << (to & 7);
+		} else {
+			dest[to >> 3] &= ~(1 << (to & 7));
+		}
+	}
+}
+
+static void prv_drop_row_cache(BoardLayerData *data, int row) {
+	if (data->row_cache[row] == NULL) {
+		return;
+	}
+	s_cache_bytes -= gbitmap_get_bytes_per_row(data->row_cache[row]) * gbitmap_get_bounds(data->row_cache[row]).size.h;
+	gbitmap_destroy(data->row_cache[row]);
+	data->row_cache[row] = NULL;
+}
+#endif
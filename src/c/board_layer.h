@@ -0,0 +1,22 @@
+#ifndef BOARD_LAYER_H
+#define BOARD_LAYER_H
+
+#include <pebble.h>
+#include "model.h"
+#include "tile.h"
+
+// Tiles are TILE_SIZE square with a 1 pixel margin for the cursor, and TILE_PITCH apart.
+#define TILE_PITCH (TILE_SIZE + 3)
+#define BOARD_LAYER_WIDTH (TILE_PITCH * WORD_LENGTH - 1)
+#define BOARD_MAX_ROWS 6
+
+typedef Layer BoardLayer;
+
+BoardLayer *board_layer_create(GPoint where, int rows);
+void board_layer_destroy(BoardLayer *layer);
+void board_layer_set_letter(BoardLayer *layer, int row, int index, char letter, LetterStatus status, bool confirmed);
+// Puts the cursor around the tile at row and index; an index of -1 hides it.
+void board_layer_set_cursor(BoardLayer *layer, int row, int index);
+void board_layer_apply_score(BoardLayer *layer, int row, LetterStatus statuses[WORD_LENGTH], bool animated);
+
+#endif
@@ -0,0 +1,58 @@
+#include <pebble.h>
+#include "calendar.h"
+
+// Works out the local day once and keeps it until the next local midnight, so that asking
+// for it is just a time() call and a comparison. A clock or timezone change can move
+// midnight, so the tick handler invalidates the cache when it's told the day changed, and
+// the cache is also dropped if the clock goes backwards.
+
+// Wordle day 0 is June 19th, 2021 in the user's local time.
+#define CALENDAR_EPOCH 1624060800
+#define SECONDS_PER_DAY 86400
+
+static bool s_valid;
+static int s_day;
+static time_t s_computed_at;
+static time_t s_next_rollover;
+
+static void prv_update();
+static int prv_utc_offset(time_t now);
+
+int calendar_get_day() {
+	prv_update();
+	return s_day;
+}
+
+time_t calendar_get_next_rollover() {
+	prv_update();
+	return s_next_rollover;
+}
+
+void calendar_invalidate() {
+	s_valid = false;
+}
+
+static void prv_update() {
+	time_t now = time(NULL);
+	if (s_valid && now >= s_computed_at && now < s_next_rollover) {
+		return;
+	}
+	int offset = prv_utc_offset(now);
+	s_day = (now + offset - CALENDAR_EPOCH) / SECONDS_PER_DAY;
+	time_t midnight = CALENDAR_EPOCH + (time_t)(s_day + 1) * SECONDS_PER_DAY;
+	// Daylight saving may start or end before then, which moves midnight by the difference.
+	s_next_rollover = midnight - prv_utc_offset(midnight - offset);
+	s_computed_at = now;
+	s_valid = true;
+}
+
+// Local time minus UTC, in seconds. The two are never more than a day apart, so comparing
+// the day of the year (or just the year, across New Year) is enough to tell which day each
+// is on, whatever the month.
+static int prv_utc_offset(time_t now) {
+	struct tm local = *localtime(&now);
+	struct tm utc = *gmtime(&now);
+	int days = local.tm_year != utc.tm_year ? local.tm_year - utc.tm_year : local.tm_yday - utc.tm_yday;
+	return days * SECONDS_PER_DAY + (local.tm_hour - utc.tm_hour) * 3600 + (local.tm_min - utc.tm_min) * 60 +
+		(local.tm_sec - utc.tm_sec);
+}
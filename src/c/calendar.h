@@ -0,0 +1,13 @@
+#ifndef CALENDAR_H
+#define CALENDAR_H
+
+#include <pebble.h>
+
+// The wordle number for today in local time.
+int calendar_get_day();
+// When the day next rolls over, as a UTC timestamp.
+time_t calendar_get_next_rollover();
+// Drops the cached day, for when the clock or the timezone may have changed.
+void calendar_invalidate();
+
+#endif
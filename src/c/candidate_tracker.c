@@ -0,0 +1,199 @@
+#include <pebble.h>
+#include "candidate_tracker.h"
+#include "model.h"
+
+// Tracks which solutions are still consistent with every guess so far, one bit each.
+// A guess is applied by ANDing in bitsets from the solution index (tools/solution_index.py):
+// greens need the letter at that position, yellows and greys rule it out there, and the
+// number of yellows, greens and greys for each letter bounds how many of it the word has.
+// Platforms that leave the bitsets out (SOLUTION_INDEX in the wscript) rescore each remaining
+// solution against the guess instead.
+
+#define ALPHABET_SIZE 26
+// Solutions read from the word list at a time: one bitset word's worth.
+#define CHUNK_WORDS 32
+
+typedef struct {
+	uint16_t solution_count;
+	uint8_t bitset_words;
+	uint8_t max_repeats;
+} __attribute__((packed)) SolutionIndexHeader;
+
+struct CandidateTracker {
+	SolutionIndexHeader header;
+	ResHandle handle;
+	int remaining;
+	uint32_t *bits;
+	uint32_t *scratch;
+};
+
+static void prv_apply_index(CandidateTracker *tracker, char guess[WORD_LENGTH], uint8_t pattern);
+static void prv_apply_bitset(CandidateTracker *tracker, int bitset, bool exclude);
+static void prv_rescore(CandidateTracker *tracker, char guess[WORD_LENGTH], uint8_t pattern);
+static int prv_load_chunk(int chunk, char words[CHUNK_WORDS][WORD_LENGTH]);
+static void prv_apply_letter_count(CandidateTracker *tracker, int letter, int at_least, bool exact);
+
+CandidateTracker *candidate_tracker_create() {
+	CandidateTracker *tracker = malloc(sizeof(CandidateTracker));
+	if (tracker == NULL) {
+		return NULL;
+	}
+	tracker->handle = resource_get_handle(RESOURCE_ID_SOLUTION_INDEX);
+	resource_load_byte_range(tracker->handle, 0, (uint8_t *)&tracker->header, sizeof(SolutionIndexHeader));
+	int words = tracker->header.bitset_words;
+	tracker->bits = malloc(words * sizeof(uint32_t));
+	tracker->scratch = malloc(words * sizeof(uint32_t));
+	if (tracker->bits == NULL || tracker->scratch == NULL) {
+		candidate_tracker_destroy(tracker);
+		return NULL;
+	}
+	tracker->remaining = tracker->header.solution_count;
+	for (int i = 0; i < words; ++i) {
+		int in_word = tracker->remaining - i * 32;
+		tracker->bits[i] = in_word >= 32 ? 0xFFFFFFFF : in_word > 0 ? (1u << in_word) - 1 : 0;
+	}
+	return tracker;
+}
+
+void candidate_tracker_destroy(CandidateTracker *tracker) {
+	if (tracker == NULL) {
+		return;
+	}
+	free(tracker->bits);
+	free(tracker->scratch);
+	free(tracker);
+}
+
+void candidate_tracker_apply_guess(CandidateTracker *tracker, char guess[WORD_LENGTH], uint8_t pattern) {
+	// A real index always has at least one repeat tier; a header-only one has none.
+	if (tracker->header.max_repeats == 0) {
+		prv_rescore(tracker, guess, pattern);
+	} else {
+		prv_apply_index(tracker, guess, pattern);
+	}
+
+	int remaining = 0;
+	for (int i = 0; i < tracker->header.bitset_words; ++i) {
+		remaining += __builtin_popcount(tracker->bits[i]);
+	}
+	tracker->remaining = remaining;
+}
+
+static void prv_apply_index(CandidateTracker *tracker, char guess[WORD_LENGTH], uint8_t pattern) {
+	LetterStatus statuses[WORD_LENGTH];
+	score_pattern_unpack(pattern, statuses);
+
+	for (int i = 0; i < WORD_LENGTH; ++i) {
+		prv_apply_bitset(tracker, i * ALPHABET_SIZE + guess[i] - 'a', statuses[i] != LetterStatusCorrect);
+	}
+
+	// Each repeated letter only needs doing once, at its first position.
+	for (int i = 0; i < WORD_LENGTH; ++i) {
+		if (memchr(guess, guess[i], i) != NULL) {
+			continue;
+		}
+		int greens = 0;
+		int found = 0;
+		bool grey = false;
+		for (int j = i; j < WORD_LENGTH; ++j) {
+			if (guess[j] != guess[i]) {
+				continue;
+			}
+			if (statuses[j] == LetterStatusNotPresent) {
+				grey = true;
+			} else {
+				++found;
+				greens += statuses[j] == LetterStatusCorrect;
+			}
+		}
+		// The green positions already guarantee that many of the letter.
+		if (found > greens || grey) {
+			prv_apply_letter_count(tracker, guess[i] - 'a', found, grey);
+		}
+	}
+}
+
+int candidate_tracker_get_count(CandidateTracker *tracker) {
+	return tracker->remaining;
+}
+
+// Fills words with up to limit of the remaining solutions. If there are more than that,
+// takes an even spread of them rather than just the first few.
+int candidate_tracker_get_words(CandidateTracker *tracker, PackedWord *words, int limit) {
+	if (tracker->remaining == 0 || limit <= 0) {
+		return 0;
+	}
+	int step = (tracker->remaining + limit - 1) / limit;
+	int seen = 0;
+	int count = 0;
+	char chunk[CHUNK_WORDS][WORD_LENGTH];
+	for (int i = 0; i < tracker->header.bitset_words && count < limit; ++i) {
+		uint32_t bits = tracker->bits[i];
+		bool loaded = false;
+		for (int j = 0; bits != 0 && count < limit; ++j, bits >>= 1) {
+			if (!(bits & 1)) {
+				continue;
+			}
+			if (seen++ % step != 0) {
+				continue;
+			}
+			if (!loaded) {
+				prv_load_chunk(i, chunk);
+				loaded = true;
+			}
+			words[count++] = word_pack(chunk[j]);
+		}
+	}
+	return count;
+}
+
+// Drops every remaining solution that wouldn't have given this guess the same score.
+static void prv_rescore(CandidateTracker *tracker, char guess[WORD_LENGTH], uint8_t pattern) {
+	PackedWord packed_guess = word_pack(guess);
+	char chunk[CHUNK_WORDS][WORD_LENGTH];
+	for (int i = 0; i < tracker->header.bitset_words; ++i) {
+		if (tracker->bits[i] == 0) {
+			continue;
+		}
+		int count = prv_load_chunk(i, chunk);
+		for (int j = 0; j < count; ++j) {
+			if ((tracker->bits[i] & (1u << j)) && score_packed(packed_guess, word_pack(chunk[j])) != pattern) {
+				tracker->bits[i] &= ~(1u << j);
+			}
+		}
+	}
+}
+
+// Loads the solutions covered by one bitset word, returning how many there are.
+static int prv_load_chunk(int chunk, char words[CHUNK_WORDS][WORD_LENGTH]) {
+	ResHandle handle = resource_get_handle(RESOURCE_ID_SOLUTION_WORDS);
+	int count = resource_size(handle) / WORD_LENGTH - chunk * CHUNK_WORDS;
+	if (count > CHUNK_WORDS) {
+		count = CHUNK_WORDS;
+	}
+	resource_load_byte_range(handle, chunk * CHUNK_WORDS * WORD_LENGTH, (uint8_t *)words, count * WORD_LENGTH);
+	return count;
+}
+
+static void prv_apply_bitset(CandidateTracker *tracker, int bitset, bool exclude) {
+	size_t size = tracker->header.bitset_words * sizeof(uint32_t);
+	resource_load_byte_range(tracker->handle, sizeof(SolutionIndexHeader) + bitset * size, (uint8_t *)tracker->scratch, size);
+	uint32_t flip = exclude ? 0xFFFFFFFF : 0;
+	for (int i = 0; i < tracker->header.bitset_words; ++i) {
+		tracker->bits[i] &= tracker->scratch[i] ^ flip;
+	}
+}
+
+static void prv_apply_letter_count(CandidateTracker *tracker, int letter, int at_least, bool exact) {
+	int first = WORD_LENGTH * ALPHABET_SIZE;
+	if (at_least > tracker->header.max_repeats) {
+		memset(tracker->bits, 0, tracker->header.bitset_words * sizeof(uint32_t));
+		return;
+	}
+	if (at_least > 0) {
+		prv_apply_bitset(tracker, first + (at_least - 1) * ALPHABET_SIZE + letter, false);
+	}
+	if (exact && at_least < tracker->header.max_repeats) {
+		prv_apply_bitset(tracker, first + at_least * ALPHABET_SIZE + letter, true);
+	}
+}
@@ -0,0 +1,16 @@
+#ifndef CANDIDATE_TRACKER_H
+#define CANDIDATE_TRACKER_H
+
+#include <pebble.h>
+#include "model.h"
+
+struct CandidateTracker;
+typedef struct CandidateTracker CandidateTracker;
+
+CandidateTracker *candidate_tracker_create();
+void candidate_tracker_destroy(CandidateTracker *tracker);
+void candidate_tracker_apply_guess(CandidateTracker *tracker, char guess[WORD_LENGTH], uint8_t pattern);
+int candidate_tracker_get_count(CandidateTracker *tracker);
+int candidate_tracker_get_words(CandidateTracker *tracker, PackedWord *words, int limit);
+
+#endif
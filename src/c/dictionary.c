@@ -0,0 +1,414 @@
+#include <pebble.h>
+#include "dictionary.h"
+#include "model.h"
+
+// The accepted word list is stored as an Elias-Fano sequence of base-26 word ranks.
+// See tools/elias_fano.py for the layout. An optional Bloom filter (tools/bloom.py),
+// sized per platform in the wscript, rejects most invalid words before we touch it.
+// Platforms with the 'perfect_hash' backend also ship a minimal perfect hash over the same
+// ranks (tools/perfect_hash.py), which answers with a single resource read instead.
+// Predictive letter input asks which letters can follow a prefix: for one or two letters the
+// answer comes from a table of word counts (tools/prefix_counts.py), and for longer prefixes
+// from walking the run of the Elias-Fano list that shares the first two letters.
+
+#define HEADER_SIZE 8
+#define PREFIX_COUNT (26 * 26)
+#define PREFIX_SPAN (26 * 26 * 26)
+#define INDEX_OFFSET HEADER_SIZE
+#define UPPER_OFFSET (INDEX_OFFSET + (PREFIX_COUNT + 1) * sizeof(uint16_t))
+
+// Must match tools/elias_fano.py, which won't build a list whose spans outgrow these.
+#define MAX_UPPER_SPAN_BYTES 48
+#define MAX_LOWER_SPAN_BYTES 48
+
+// As in vendor/qrcodegen.c: the SDK has no assert handler to link against, so on the watch a
+// failed check is only logged, and the lookup gives up rather than read past its buffer. The
+// host shim has the real one.
+#ifndef assert
+#define assert(x) do {if (!(x)) { APP_LOG(APP_LOG_LEVEL_ERROR, "assertion failed: %s", #x);}} while(0)
+#endif
+
+typedef struct {
+	uint16_t word_count;
+	uint8_t lower_bits;
+	uint8_t max_bucket;
+	uint16_t upper_bytes;
+	uint16_t lower_bytes;
+} __attribute__((packed)) DictionaryHeader;
+
+typedef struct {
+	uint16_t byte_count;
+	uint8_t hash_count;
+	uint8_t reserved;
+} __attribute__((packed)) BloomHeader;
+
+typedef struct {
+	uint16_t word_count;
+	uint16_t bucket_count;
+	uint16_t dense_buckets;
+	uint16_t dense_threshold;
+	uint16_t salt;
+} __attribute__((packed)) PerfectHashHeader;
+
+#define PERFECT_HASH_SLOT_SIZE 3
+
+static DictionaryHeader s_header;
+static bool s_header_loaded;
+static ResHandle s_handle;
+static uint16_t *s_prefix_index;
+static BloomHeader s_bloom_header;
+static uint8_t *s_bloom_bits;
+static PerfectHashHeader s_hash_header;
+static uint16_t *s_hash_seeds;
+static ResHandle s_hash_handle;
+
+static ResHandle prv_handle();
+static void prv_load_header();
+static void prv_load_prefix_bounds(int prefix, uint16_t bounds[2]);
+static void prv_load_bloom_filter();
+static bool prv_bloom_may_contain(uint32_t rank);
+static void prv_load_perfect_hash();
+static bool prv_perfect_hash_contains(uint32_t rank);
+static bool prv_elias_fano_contains(uint32_t rank);
+static void prv_elias_fano_count_next(char *prefix, int length, uint16_t counts[26]);
+static uint32_t prv_word_rank(char word[WORD_LENGTH]);
+static bool prv_get_bit(uint8_t *buffer, int bit);
+static uint32_t prv_get_bits(uint8_t *buffer, int bit, int count);
+
+void dictionary_init() {
+	prv_load_header();
+	prv_load_bloom_filter();
+	prv_load_perfect_hash();
+	// The perfect hash never looks at the prefix index, so don't spend RAM on both.
+	if (s_prefix_index != NULL || s_hash_seeds != NULL) {
+		return;
+	}
+	// The prefix index is small enough (~1.4 KB) to keep in RAM, which saves a resource
+	// read on every lookup.
+	size_t size = (PREFIX_COUNT + 1) * sizeof(uint16_t);
+	s_prefix_index = malloc(size);
+	if (s_prefix_index == NULL) {
+		APP_LOG(APP_LOG_LEVEL_WARNING, "Couldn't allocate the dictionary prefix index; falling back to resource reads.");
+		return;
+	}
+	resource_load_byte_range(prv_handle(), INDEX_OFFSET, (uint8_t *)s_prefix_index, size);
+}
+
+void dictionary_deinit() {
+	free(s_prefix_index);
+	s_prefix_index = NULL;
+	free(s_bloom_bits);
+	s_bloom_bits = NULL;
+	free(s_hash_seeds);
+	s_hash_seeds = NULL;
+}
+
+bool dictionary_contains(char word[WORD_LENGTH]) {
+	uint32_t rank = prv_word_rank(word);
+	if (!prv_bloom_may_contain(rank)) {
+		return false;
+	}
+	if (s_hash_seeds != NULL) {
+		return prv_perfect_hash_contains(rank);
+	}
+	return prv_elias_fano_contains(rank);
+}
+
+void dictionary_count_next_letters(char *prefix, int length, uint16_t counts[26]) {
+	memset(counts, 0, 26 * sizeof(uint16_t));
+	if (length >= WORD_LENGTH) {
+		return;
+	}
+	if (length >= 2) {
+		prv_elias_fano_count_next(prefix, length, counts);
+		return;
+	}
+	size_t offset = length == 0 ? 0 : (26 + (prefix[0] - 'a') * 26) * sizeof(uint16_t);
+	resource_load_byte_range(resource_get_handle(RESOURCE_ID_PREFIX_COUNTS), offset, (uint8_t *)counts, 26 * sizeof(uint16_t));
+}
+
+static bool prv_elias_fano_contains(uint32_t rank) {
+	prv_load_header();
+	DictionaryHeader *h = &s_header;
+	ResHandle handle = prv_handle();
+
+	int prefix = rank / PREFIX_SPAN;
+	int high = rank >> h->lower_bits;
+	uint32_t low = rank & ((1 << h->lower_bits) - 1);
+
+	uint16_t bounds[2];
+	prv_load_prefix_bounds(prefix, bounds);
+	int prefix_high = (prefix * PREFIX_SPAN) >> h->lower_bits;
+
+	// Read just enough of the upper stream to cover every element whose upper value is
+	// at most `high`. The bucket for `high` can run past the next prefix's start by at
+	// most max_bucket elements.
+	int start_bit = bounds[0] + prefix_high;
+	int end_bit = bounds[1] + high + h->max_bucket + 1;
+	if (end_bit > h->upper_bytes * 8) {
+		end_bit = h->upper_bytes * 8;
+	}
+	int start_byte = start_bit / 8;
+	int upper_length = (end_bit + 7) / 8 - start_byte;
+	assert(upper_length <= MAX_UPPER_SPAN_BYTES);
+	if (upper_length > MAX_UPPER_SPAN_BYTES) {
+		return false;
+	}
+	uint8_t upper[MAX_UPPER_SPAN_BYTES];
+	resource_load_byte_range(handle, UPPER_OFFSET + start_byte, upper, upper_length);
+
+	int current_high = prefix_high;
+	int index = bounds[0];
+	int first_match = -1;
+	int match_count = 0;
+	for (int bit = start_bit - start_byte * 8; bit < upper_length * 8 && current_high <= high; ++bit) {
+		if (prv_get_bit(upper, bit)) {
+			if (current_high == high) {
+				if (first_match < 0) {
+					first_match = index;
+				}
+				++match_count;
+			}
+			++index;
+		} else {
+			++current_high;
+		}
+	}
+	if (match_count == 0) {
+		return false;
+	}
+
+	int lower_start_bit = first_match * h->lower_bits;
+	int lower_start_byte = lower_start_bit / 8;
+	int lower_length = (lower_start_bit + match_count * h->lower_bits + 7) / 8 - lower_start_byte;
+	assert(lower_length <= MAX_LOWER_SPAN_BYTES);
+	if (lower_length > MAX_LOWER_SPAN_BYTES) {
+		return false;
+	}
+	uint8_t lower[MAX_LOWER_SPAN_BYTES];
+	resource_load_byte_range(handle, UPPER_OFFSET + h->upper_bytes + lower_start_byte, lower, lower_length);
+
+	// Lower values within a bucket are sorted, so we can stop as soon as we pass ours.
+	for (int i = 0; i < match_count; ++i) {
+		uint32_t value = prv_get_bits(lower, lower_start_bit - lower_start_byte * 8 + i * h->lower_bits, h->lower_bits);
+		if (value == low) {
+			return true;
+		}
+		if (value > low) {
+			break;
+		}
+	}
+	return false;
+}
+
+// Walks every rank sharing the prefix's first two letters, tallying the letter after the
+// prefix in those that match the rest of it.
+static void prv_elias_fano_count_next(char *prefix, int length, uint16_t counts[26]) {
+	prv_load_header();
+	DictionaryHeader *h = &s_header;
+	ResHandle handle = prv_handle();
+
+	int prefix_id = (prefix[0] - 'a') * 26 + (prefix[1] - 'a');
+	uint32_t first_rank = prefix_id * PREFIX_SPAN;
+	uint32_t last_rank = first_rank + PREFIX_SPAN - 1;
+	int first_high = first_rank >> h->lower_bits;
+	int last_high = last_rank >> h->lower_bits;
+
+	uint16_t bounds[2];
+	prv_load_prefix_bounds(prefix_id, bounds);
+	int start_bit = bounds[0] + first_high;
+	int end_bit = bounds[1] + last_high + h->max_bucket + 1;
+	if (end_bit > h->upper_bytes * 8) {
+		end_bit = h->upper_bytes * 8;
+	}
+	int start_byte = start_bit / 8;
+	int upper_length = (end_bit + 7) / 8 - start_byte;
+	assert(upper_length <= MAX_UPPER_SPAN_BYTES);
+	if (upper_length > MAX_UPPER_SPAN_BYTES) {
+		return;
+	}
+	uint8_t upper[MAX_UPPER_SPAN_BYTES];
+	resource_load_byte_range(handle, UPPER_OFFSET + start_byte, upper, upper_length);
+
+	// A busy prefix has more lower values than fit in one buffer, so they're read a chunk at
+	// a time as the walk reaches them.
+	uint8_t lower[MAX_LOWER_SPAN_BYTES];
+	int chunk_size = (MAX_LOWER_SPAN_BYTES * 8 - 7) / h->lower_bits;
+	int chunk_start = -1;
+	int chunk_bit = 0;
+
+	// The digits after the first two letters; the first of them is the most significant.
+	int divisors[WORD_LENGTH - 2] = {26 * 26, 26, 1};
+	int current_high = first_high;
+	int index = bounds[0];
+	for (int bit = start_bit - start_byte * 8; bit < upper_length * 8 && current_high <= last_high; ++bit) {
+		if (!prv_get_bit(upper, bit)) {
+			++current_high;
+			continue;
+		}
+		if (chunk_start < 0 || index >= chunk_start + chunk_size) {
+			chunk_start = index;
+			int lower_start_bit = index * h->lower_bits;
+			int lower_start_byte = lower_start_bit / 8;
+			int lower_length = (lower_start_bit + chunk_size * h->lower_bits + 7) / 8 - lower_start_byte;
+			if (lower_start_byte + lower_length > h->lower_bytes) {
+				lower_length = h->lower_bytes - lower_start_byte;
+			}
+			resource_load_byte_range(handle, UPPER_OFFSET + h->upper_bytes + lower_start_byte, lower, lower_length);
+			chunk_bit = lower_start_bit - lower_start_byte * 8;
+		}
+		uint32_t low = prv_get_bits(lower, chunk_bit + (index - chunk_start) * h->lower_bits, h->lower_bits);
+		uint32_t rank = ((uint32_t)current_high << h->lower_bits) | low;
+		++index;
+		if (rank < first_rank || rank > last_rank) {
+			continue;
+		}
+		int rest = rank - first_rank;
+		bool matches = true;
+		for (int i = 2; i < length && matches; ++i) {
+			matches = rest / divisors[i - 2] % 26 == prefix[i] - 'a';
+		}
+		if (matches) {
+			++counts[rest / divisors[length - 2] % 26];
+		}
+	}
+}
+
+static ResHandle prv_handle() {
+	if (s_handle == NULL) {
+		s_handle = resource_get_handle(RESOURCE_ID_ACCEPTABLE_WORDS);
+	}
+	return s_handle;
+}
+
+static void prv_load_header() {
+	if (s_header_loaded) {
+		return;
+	}
+	resource_load_byte_range(prv_handle(), 0, (uint8_t *)&s_header, sizeof(DictionaryHeader));
+	s_header_loaded = true;
+}
+
+static void prv_load_prefix_bounds(int prefix, uint16_t bounds[2]) {
+	if (s_prefix_index != NULL) {
+		bounds[0] = s_prefix_index[prefix];
+		bounds[1] = s_prefix_index[prefix + 1];
+		return;
+	}
+	resource_load_byte_range(prv_handle(), INDEX_OFFSET + prefix * sizeof(uint16_t), (uint8_t *)bounds, 2 * sizeof(uint16_t));
+}
+
+static void prv_load_bloom_filter() {
+	if (s_bloom_bits != NULL) {
+		return;
+	}
+	ResHandle handle = resource_get_handle(RESOURCE_ID_BLOOM_FILTER);
+	resource_load_byte_range(handle, 0, (uint8_t *)&s_bloom_header, sizeof(BloomHeader));
+	if (s_bloom_header.byte_count == 0 || s_bloom_header.hash_count == 0) {
+		return;
+	}
+	s_bloom_bits = malloc(s_bloom_header.byte_count);
+	if (s_bloom_bits == NULL) {
+		APP_LOG(APP_LOG_LEVEL_WARNING, "Couldn't allocate %d bytes for the Bloom filter; skipping it.", s_bloom_header.byte_count);
+		return;
+	}
+	resource_load_byte_range(handle, sizeof(BloomHeader), s_bloom_bits, s_bloom_header.byte_count);
+}
+
+static void prv_load_perfect_hash() {
+	if (s_hash_seeds != NULL) {
+		return;
+	}
+	s_hash_handle = resource_get_handle(RESOURCE_ID_ACCEPTABLE_WORDS_HASH);
+	resource_load_byte_range(s_hash_handle, 0, (uint8_t *)&s_hash_header, sizeof(PerfectHashHeader));
+	if (s_hash_header.word_count == 0) {
+		return;
+	}
+	size_t size = s_hash_header.bucket_count * sizeof(uint16_t);
+	s_hash_seeds = malloc(size);
+	if (s_hash_seeds == NULL) {
+		APP_LOG(APP_LOG_LEVEL_WARNING, "Couldn't allocate %d bytes for the perfect hash; using the word list instead.", (int)size);
+		return;
+	}
+	resource_load_byte_range(s_hash_handle, sizeof(PerfectHashHeader), (uint8_t *)s_hash_seeds, size);
+}
+
+// Must match fmix32() in tools/perfect_hash.py.
+static uint32_t prv_fmix32(uint32_t x) {
+	x ^= x >> 16;
+	x *= 0x85EBCA6B;
+	x ^= x >> 13;
+	x *= 0xC2B2AE35;
+	x ^= x >> 16;
+	return x;
+}
+
+static uint32_t prv_hash_rank(uint32_t rank, uint32_t seed) {
+	return prv_fmix32(rank ^ (seed * 0x9E3779B9));
+}
+
+// Must match bucket_for() in tools/perfect_hash.py.
+static int prv_perfect_hash_bucket(uint32_t rank) {
+	PerfectHashHeader *h = &s_hash_header;
+	uint32_t hash = prv_hash_rank(rank, 0x10000 + h->salt);
+	if ((hash & 0xFFFF) < h->dense_threshold) {
+		return (hash >> 16) % h->dense_buckets;
+	}
+	return h->dense_buckets + (hash >> 16) % (h->bucket_count - h->dense_buckets);
+}
+
+static bool prv_perfect_hash_contains(uint32_t rank) {
+	PerfectHashHeader *h = &s_hash_header;
+	uint16_t seed = s_hash_seeds[prv_perfect_hash_bucket(rank)];
+	uint32_t slot = prv_hash_rank(rank, seed) % h->word_count;
+	size_t offset = sizeof(PerfectHashHeader) + h->bucket_count * sizeof(uint16_t) + slot * PERFECT_HASH_SLOT_SIZE;
+	uint8_t stored[PERFECT_HASH_SLOT_SIZE];
+	resource_load_byte_range(s_hash_handle, offset, stored, PERFECT_HASH_SLOT_SIZE);
+	return (stored[0] | (stored[1] << 8) | ((uint32_t)stored[2] << 16)) == rank;
+}
+
+// Must match mix32() in tools/bloom.py.
+static uint32_t prv_mix32(uint32_t x) {
+	x *= 0x9E3779B1;
+	x ^= x >> 15;
+	x *= 0x85EBCA77;
+	x ^= x >> 13;
+	return x;
+}
+
+static bool prv_bloom_may_contain(uint32_t rank) {
+	if (s_bloom_bits == NULL) {
+		return true;
+	}
+	uint32_t bit_count = s_bloom_header.byte_count * 8;
+	uint32_t hash = prv_mix32(rank);
+	uint32_t h1 = hash & 0xFFFF;
+	uint32_t h2 = (hash >> 16) | 1;
+	for (int i = 0; i < s_bloom_header.hash_count; ++i) {
+		uint32_t bit = (h1 + i * h2) % bit_count;
+		if (!prv_get_bit(s_bloom_bits, bit)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static uint32_t prv_word_rank(char word[WORD_LENGTH]) {
+	uint32_t rank = 0;
+	for (int i = 0; i < WORD_LENGTH; ++i) {
+		rank = rank * 26 + (word[i] - 'a');
+	}
+	return rank;
+}
+
+static bool prv_get_bit(uint8_t *buffer, int bit) {
+	return (buffer[bit >> 3] >> (bit & 7)) & 1;
+}
+
+static uint32_t prv_get_bits(uint8_t *buffer, int bit, int count) {
+	uint32_t value = 0;
+	for (int i = 0; i < count; ++i) {
+		value |= (uint32_t)prv_get_bit(buffer, bit + i) << i;
+	}
+	return value;
+}
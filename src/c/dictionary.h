@@ -0,0 +1,13 @@
+#ifndef DICTIONARY_H
+#define DICTIONARY_H
+
+#include <pebble.h>
+#include "model.h"
+
+void dictionary_init();
+void dictionary_deinit();
+bool dictionary_contains(char word[WORD_LENGTH]);
+// Counts the accepted words that continue the first `length` letters of prefix with each letter.
+void dictionary_count_next_letters(char *prefix, int length, uint16_t counts[26]);
+
+#endif
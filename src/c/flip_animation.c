@@ -0,0 +1,69 @@
+#include <pebble.h>
+#include "flip_animation.h"
+#include "tile.h"
+
+// Rather than a pair of property animations per tile, there's one Animation for the whole run,
+// and each frame works out where every tile is in its flip from the time elapsed.
+
+#define FLIP_HALF_DURATION (FLIP_DURATION / 2)
+
+static void prv_update(Animation *animation, const AnimationProgress progress);
+static void prv_stopped(Animation *animation, bool finished, void *context);
+
+static const AnimationImplementation s_implementation = {
+	.update = prv_update,
+};
+
+void flip_animation_start(FlipAnimation *flip, int tiles, int stagger, FlipAnimationUpdate update, void *context) {
+	flip_animation_stop(flip);
+	flip->tiles = tiles;
+	flip->stagger = stagger;
+	flip->update = update;
+	flip->context = context;
+	flip->animation = animation_create();
+	if (flip->animation == NULL) {
+		for (int i = 0; i < tiles; ++i) {
+			update(i, TILE_SIZE, true, context);
+		}
+		return;
+	}
+	animation_set_implementation(flip->animation, &s_implementation);
+	animation_set_duration(flip->animation, (tiles - 1) * stagger + FLIP_DURATION);
+	animation_set_curve(flip->animation, AnimationCurveLinear);
+	animation_set_handlers(flip->animation, (AnimationHandlers) { .stopped = prv_stopped }, flip);
+	animation_schedule(flip->animation);
+}
+
+void flip_animation_stop(FlipAnimation *flip) {
+	if (flip->animation != NULL) {
+		animation_unschedule(flip->animation);
+	}
+}
+
+static void prv_update(Animation *animation, const AnimationProgress progress) {
+	FlipAnimation *flip = animation_get_context(animation);
+	int duration = (flip->tiles - 1) * flip->stagger + FLIP_DURATION;
+	int elapsed = (int)progress * duration / ANIMATION_NORMALIZED_MAX;
+	for (int i = 0; i < flip->tiles; ++i) {
+		int t = elapsed - i * flip->stagger;
+		if (t <= 0) {
+			break;
+		}
+		if (t < FLIP_HALF_DURATION) {
+			flip->update(i, TILE_SIZE - (TILE_SIZE - FLIP_MIN_HEIGHT) * t / FLIP_HALF_DURATION, false, flip->context);
+		} else if (t < FLIP_DURATION) {
+			flip->update(i, FLIP_MIN_HEIGHT + (TILE_SIZE - FLIP_MIN_HEIGHT) * (t - FLIP_HALF_DURATION) / FLIP_HALF_DURATION, true, flip->context);
+		} else {
+			flip->update(i, TILE_SIZE, true, flip->context);
+		}
+	}
+}
+
+// Also called when the flip is cut short, so every tile is left turned over.
+static void prv_stopped(Animation *animation, bool finished, void *context) {
+	FlipAnimation *flip = context;
+	flip->animation = NULL;
+	for (int i = 0; i < flip->tiles; ++i) {
+		flip->update(i, TILE_SIZE, true, flip->context);
+	}
+}
@@ -0,0 +1,29 @@
+#ifndef FLIP_ANIMATION_H
+#define FLIP_ANIMATION_H
+
+#include <pebble.h>
+
+// A tile flips by shrinking to FLIP_MIN_HEIGHT over half of FLIP_DURATION, turning over to
+// its new face, and growing back over the other half.
+#define FLIP_DURATION 300
+#define FLIP_MIN_HEIGHT 2
+
+// Called with a tile's height as it flips, and whether it has turned over yet.
+typedef void (*FlipAnimationUpdate)(int tile, int height, bool turned, void *context);
+
+// Flips a run of tiles, each starting stagger ms after the one before, as one Animation. The
+// struct is owned by the caller, typically in its layer's data.
+typedef struct {
+	Animation *animation;
+	int tiles;
+	int stagger;
+	FlipAnimationUpdate update;
+	void *context;
+} FlipAnimation;
+
+// Starts flipping, first finishing off any flip this one is still running.
+void flip_animation_start(FlipAnimation *flip, int tiles, int stagger, FlipAnimationUpdate update, void *context);
+// Stops flipping, leaving every tile turned over and at its full height.
+void flip_animation_stop(FlipAnimation *flip);
+
+#endif
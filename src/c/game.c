@@ -1,29 +1,39 @@
 #include <pebble.h>
 #include "game.h"
 #include "model.h"
-#include "word_layer.h"
+#include "dictionary.h"
+#include "board_layer.h"
 #include "notify_layer.h"
 #include "stat_tracker.h"
+#include "share_code.h"
 #include "stat_window.h"
+#include "candidate_tracker.h"
+#include "hint_engine.h"
+#include "game_state.h"
 
-typedef struct {
-	int guess_number;
-	int current_char;
-	int word_number;
-	GameStatus status;
-	char guesses[GUESS_LIMIT][WORD_LENGTH];
-	LetterStatus alphabet_status[26];
-} __attribute__((packed)) GameState;
+// How long the "N words left" note stays up if nobody dismisses it.
+#define REMAINING_NOTIFY_TIMEOUT 2000
+// The widest message shown while a hint is worked out; progress stops short of 100%.
+#define HINT_PROGRESS_WIDEST "Thinking... 99%"
 
 char *VICTORY_MESSAGES[GUESS_LIMIT] = {"Genius", "Magnificent", "Impressive", "Splendid", "Great", "Phew"};
 
 static Window *s_window;
-static WordLayer *s_guess_layers[GUESS_LIMIT];
+static BoardLayer *s_board;
 static NotifyLayer *s_notify_layer;
+static AppTimer *s_notify_timer;
+static CandidateTracker *s_candidates;
+static HintEngine *s_hint;
 static GameState s_game_state;
 static bool s_animation_lock;
 static bool s_loaded;
 static char s_word[WORD_LENGTH];
+// The letters up and down step through on the tile under the cursor: those that lead to an
+// accepted word, most common first. They're worked out when the cursor reaches a tile, not on
+// every press.
+static char s_letter_order[26];
+static int s_letter_order_count;
+static int s_letter_order_tile;
 
 
 static void prv_init();
@@ -34,9 +44,15 @@ static void prv_handle_select(ClickRecognizerRef recognizer, void *ctx);
 static void prv_handle_back(ClickRecognizerRef recognizer, void *ctx);
 static void prv_handle_up(ClickRecognizerRef recognizer, void *ctx);
 static void prv_handle_down(ClickRecognizerRef recognizer, void *ctx);
+static void prv_handle_hint(ClickRecognizerRef recognizer, void *ctx);
+static bool prv_interrupt_hint();
+static void prv_hint_progress(int percent, void *context);
+static void prv_hint_done(char word[WORD_LENGTH], void *context);
 static void prv_cycle_letter(int direction);
+static void prv_update_letter_order();
 static void prv_update_alphabet_status(char letter, LetterStatus status);
 static void prv_notify(char* message);
+static void prv_notify_timeout(void *context);
 static void prv_animation_complete(void *context);
 static void prv_save_state();
 static void prv_restore_state();
@@ -81,47 +97,56 @@ static void prv_init() {
 }
 
 static void prv_window_load(Window *window) {
-	for (int i = 0; i < GUESS_LIMIT; ++i) {
-		s_guess_layers[i] = word_layer_create(GPoint(7, 6 + i * (WORD_LAYER_HEIGHT + 1)));
-		layer_add_child(window_get_root_layer(window), s_guess_layers[i]);
-	}
+	s_board = board_layer_create(GPoint(7, 6), GUESS_LIMIT);
+	layer_add_child(window_get_root_layer(window), s_board);
 	prv_restore_state();
+	s_letter_order_tile = -1;
 	GameState *s = &s_game_state;
 	for (int i = 0; i < s->guess_number; ++i) {
 		for (int j = 0; j < WORD_LENGTH; ++j) {
-			word_layer_set_letter(s_guess_layers[i], j, s->guesses[i][j], LetterStatusNeutral, false);
+			board_layer_set_letter(s_board, i, j, s->guesses[i][j], LetterStatusNeutral, false);
 		}
 		LetterStatus statuses[WORD_LENGTH];
 		score_word(s->guesses[i], s_word, statuses);
-		word_layer_apply_score(s_guess_layers[i], statuses, false);
+		board_layer_apply_score(s_board, i, statuses, false);
+	}
+	if (s->status == GameStatusPlaying) {
+		s_candidates = candidate_tracker_create();
+		for (int i = 0; s_candidates != NULL && i < s->guess_number; ++i) {
+			candidate_tracker_apply_guess(s_candidates, s->guesses[i], score_word_packed(s->guesses[i], s_word));
+		}
 	}
 	for (int j = 0; j < WORD_LENGTH; ++j) {
 		if (s->guesses[s->guess_number][j] == 0) {
 			break;
 		}
-		word_layer_set_letter(s_guess_layers[s->guess_number], j, s->guesses[s->guess_number][j], s->alphabet_status[s->guesses[s->guess_number][j] - 'a'], s->status != GameStatusPlaying);
+		board_layer_set_letter(s_board, s->guess_number, j, s->guesses[s->guess_number][j], s->alphabet_status[s->guesses[s->guess_number][j] - 'a'], s->status != GameStatusPlaying);
 	}
 	if (s->status == GameStatusPlaying) {
-		word_layer_set_cursor(s_guess_layers[s_game_state.guess_number], s_game_state.current_char);
+		board_layer_set_cursor(s_board, s_game_state.guess_number, s_game_state.current_char);
 	}
 }
 
 static void prv_window_unload(Window *window) {
 	prv_save_state();
-	for (int i = 0; i < GUESS_LIMIT; ++i) {
-		word_layer_destroy(s_guess_layers[i]);
-	}
+	board_layer_destroy(s_board);
 	if (s_notify_layer != NULL) {
 		notify_layer_destroy(s_notify_layer);
 		s_notify_layer = NULL;
 		s_animation_lock = false;
 	}
+	if (s_notify_timer != NULL) {
+		app_timer_cancel(s_notify_timer);
+		s_notify_timer = NULL;
+	}
+	hint_engine_destroy(s_hint);
+	s_hint = NULL;
+	candidate_tracker_destroy(s_candidates);
+	s_candidates = NULL;
 }
 
 static void prv_save_state() {
-	APP_LOG(APP_LOG_LEVEL_INFO, "prv_save_state()");
-	persist_write_int(1, 1);
-	persist_write_data(2, &s_game_state, sizeof(GameState));
+	game_state_save(&s_game_state);
 }
 
 static void prv_restore_state() {
@@ -133,9 +158,8 @@ static void prv_restore_state() {
 	GameState *s = &s_game_state;
 	word_of_the_day(s_word);
 	int word_number = wordle_number();
-	if (persist_read_int(1) == 1) {
-		APP_LOG(APP_LOG_LEVEL_INFO, "usable state shuold be present, loading...");
-		persist_read_data(2, s, sizeof(GameState));
+	if (game_state_load(s)) {
+		APP_LOG(APP_LOG_LEVEL_INFO, "usable state should be present, loading...");
 		if (s->word_number == word_number) {
 			APP_LOG(APP_LOG_LEVEL_INFO, "using loaded state");
 			s_loaded = true;
@@ -150,13 +174,14 @@ static void prv_restore_state() {
 
 static void prv_click_config_provider(void *ctx) {
 	window_single_click_subscribe(BUTTON_ID_SELECT, prv_handle_select);
+	window_long_click_subscribe(BUTTON_ID_SELECT, 0, prv_handle_hint, NULL);
 	window_single_click_subscribe(BUTTON_ID_BACK, prv_handle_back);
 	window_single_repeating_click_subscribe(BUTTON_ID_UP, 100, prv_handle_up);
 	window_single_repeating_click_subscribe(BUTTON_ID_DOWN, 100, prv_handle_down);
 }
 
 static void prv_handle_up(ClickRecognizerRef recognizer, void *ctx) {
-	if (s_animation_lock) {
+	if (s_animation_lock || prv_interrupt_hint()) {
 		return;
 	}
 	if (s_notify_layer != NULL) {
@@ -167,7 +192,7 @@ static void prv_handle_up(ClickRecognizerRef recognizer, void *ctx) {
 }
 
 static void prv_handle_down(ClickRecognizerRef recognizer, void *ctx) {
-	if (s_animation_lock) {
+	if (s_animation_lock || prv_interrupt_hint()) {
 		return;
 	}
 	if (s_notify_layer != NULL) {
@@ -183,7 +208,20 @@ static void prv_cycle_letter(int direction) {
 		return;
 	}
 	char c = s->guesses[s->guess_number][s->current_char];
-	if (c == 0) {
+	prv_update_letter_order();
+	if (s_letter_order_count > 0) {
+		int i = 0;
+		while (i < s_letter_order_count && s_letter_order[i] != c) {
+			++i;
+		}
+		if (i == s_letter_order_count) {
+			i = direction > 0 ? 0 : s_letter_order_count - 1;
+		} else {
+			i = (i + direction + s_letter_order_count) % s_letter_order_count;
+		}
+		c = s_letter_order[i];
+	} else if (c == 0) {
+		// Nothing accepted starts this way, so fall back to the whole alphabet.
 		c =  direction > 0 ? 'a' : 'z';
 	} else {
 		c += direction;
@@ -191,12 +229,45 @@ static void prv_cycle_letter(int direction) {
 		else if (c < 'a') c = 'z';
 	}
 	s->guesses[s->guess_number][s->current_char] = c;
-	word_layer_set_letter(s_guess_layers[s->guess_number], s->current_char, c, s->alphabet_status[c - 'a'], false);
+	board_layer_set_letter(s_board, s->guess_number, s->current_char, c, s->alphabet_status[c - 'a'], false);
+}
+
+// Letters known not to be in the word are left out, unless that leaves nothing, as it can
+// when the player is spending a guess on a word they know can't win.
+static void prv_update_letter_order() {
+	GameState *s = &s_game_state;
+	int tile = s->guess_number * WORD_LENGTH + s->current_char;
+	if (tile == s_letter_order_tile) {
+		return;
+	}
+	s_letter_order_tile = tile;
+	uint16_t counts[26];
+	dictionary_count_next_letters(s->guesses[s->guess_number], s->current_char, counts);
+	bool skip_absent = false;
+	for (int i = 0; i < 26; ++i) {
+		if (counts[i] > 0 && s->alphabet_status[i] != LetterStatusNotPresent) {
+			skip_absent = true;
+			break;
+		}
+	}
+	s_letter_order_count = 0;
+	for (int i = 0; i < 26; ++i) {
+		if (counts[i] == 0 || (skip_absent && s->alphabet_status[i] == LetterStatusNotPresent)) {
+			continue;
+		}
+		// Insertion sort, keeping alphabetical order among letters with the same count.
+		int j = s_letter_order_count++;
+		while (j > 0 && counts[s_letter_order[j - 1] - 'a'] < counts[i]) {
+			s_letter_order[j] = s_letter_order[j - 1];
+			--j;
+		}
+		s_letter_order[j] = 'a' + i;
+	}
 }
 
 static void prv_handle_select(ClickRecognizerRef recognizer, void *ctx) {
 	GameState *s = &s_game_state;
-	if (s_animation_lock) {
+	if (s_animation_lock || prv_interrupt_hint()) {
 		return;
 	}
 	if (s->status != GameStatusPlaying) {
@@ -212,7 +283,7 @@ static void prv_handle_select(ClickRecognizerRef recognizer, void *ctx) {
 		if (s->guess_number > 0) {
 			char c = s->guesses[s->guess_number-1][s->current_char];
 			s->guesses[s->guess_number][s->current_char] = c;
-			word_layer_set_letter(s_guess_layers[s->guess_number], s->current_char, c, s->alphabet_status[c - 'a'], false);
+			board_layer_set_letter(s_board, s->guess_number, s->current_char, c, s->alphabet_status[c - 'a'], false);
 		} else {
 			vibes_short_pulse();
 		}
@@ -220,7 +291,7 @@ static void prv_handle_select(ClickRecognizerRef recognizer, void *ctx) {
 	}
 	if (s->current_char < WORD_LENGTH - 1) {
 		++s->current_char;
-		word_layer_set_cursor(s_guess_layers[s->guess_number], s->current_char);
+		board_layer_set_cursor(s_board, s->guess_number, s->current_char);
 		return;
 	}
 	if (!is_valid_word(s->guesses[s->guess_number])) {
@@ -238,8 +309,11 @@ static void prv_handle_select(ClickRecognizerRef recognizer, void *ctx) {
 	}
 	APP_LOG(APP_LOG_LEVEL_INFO, "Word was correct: %d", correct);
 	APP_LOG(APP_LOG_LEVEL_INFO, "Statuses: %d%d%d%d%d", statuses[0], statuses[1], statuses[2], statuses[3], statuses[4]);
-	word_layer_apply_score(s_guess_layers[s->guess_number], statuses, true);
-	word_layer_set_cursor(s_guess_layers[s->guess_number], -1);
+	board_layer_apply_score(s_board, s->guess_number, statuses, true);
+	board_layer_set_cursor(s_board, s->guess_number, -1);
+	if (s_candidates != NULL && !correct) {
+		candidate_tracker_apply_guess(s_candidates, s->guesses[s->guess_number], score_word_packed(s->guesses[s->guess_number], s_word));
+	}
 	if (correct) {
 		s->status = GameStatusWon;
 		prv_record_result();
@@ -252,6 +326,7 @@ static void prv_handle_select(ClickRecognizerRef recognizer, void *ctx) {
 			s->current_char = 0;
 		}
 	}
+	prv_save_state();
 	s_animation_lock = true;
 	app_timer_register(1500, prv_animation_complete, NULL);
 }
@@ -266,6 +341,11 @@ static void prv_record_result() {
 	}
 	stat_tracker_record_result(tracker, s_game_state.word_number, result);
 	stat_tracker_destroy(tracker);
+
+	LetterStatus statuses[GUESS_LIMIT][WORD_LENGTH];
+	memset(statuses, 0, sizeof(statuses));
+	game_get_guesses(statuses);
+	share_code_precompute(s_game_state.word_number, statuses);
 }
 
 static void prv_animation_complete(void *context) {
@@ -278,12 +358,19 @@ static void prv_animation_complete(void *context) {
 		memcpy(message + 1, s_word, 5);
 		prv_notify(message);
 	} else {
-		word_layer_set_cursor(s_guess_layers[s->guess_number], 0);
+		board_layer_set_cursor(s_board, s->guess_number, 0);
+		if (s_candidates != NULL) {
+			int remaining = candidate_tracker_get_count(s_candidates);
+			char message[20];
+			snprintf(message, sizeof(message), remaining == 1 ? "%d word left" : "%d words left", remaining);
+			prv_notify(message);
+			s_notify_timer = app_timer_register(REMAINING_NOTIFY_TIMEOUT, prv_notify_timeout, NULL);
+		}
 	}
 }
 
 static void prv_handle_back(ClickRecognizerRef recognizer, void *ctx) {
-	if (s_animation_lock) {
+	if (s_animation_lock || prv_interrupt_hint()) {
 		return;
 	}
 	GameState *s = &s_game_state;
@@ -297,12 +384,60 @@ static void prv_handle_back(ClickRecognizerRef recognizer, void *ctx) {
 	}
 	if (s->current_char > 0) {
 		--s->current_char;
-		word_layer_set_cursor(s_guess_layers[s->guess_number], s->current_char);
+		board_layer_set_cursor(s_board, s->guess_number, s->current_char);
 	} else {
 		window_stack_pop(true);
 	}
 }
 
+static void prv_handle_hint(ClickRecognizerRef recognizer, void *ctx) {
+	if (s_animation_lock || s_hint != NULL || s_candidates == NULL || s_game_state.status != GameStatusPlaying) {
+		return;
+	}
+	s_hint = hint_engine_start(s_candidates, (HintEngineHandlers) {
+		.progress = prv_hint_progress,
+		.done = prv_hint_done,
+	}, NULL);
+	if (s_hint != NULL) {
+		// The box is sized for the widest progress message up front, so it stays put as the
+		// percentage changes and each update only redraws the text.
+		prv_notify(HINT_PROGRESS_WIDEST);
+		notify_layer_set_text(s_notify_layer, "Thinking...");
+	}
+}
+
+// Any button while a hint is being worked out stops it and shows the best guess so far.
+static bool prv_interrupt_hint() {
+	if (s_hint == NULL) {
+		return false;
+	}
+	char word[WORD_LENGTH];
+	if (hint_engine_get_best(s_hint, word)) {
+		prv_hint_done(word, NULL);
+	} else {
+		hint_engine_destroy(s_hint);
+		s_hint = NULL;
+		prv_notify(NULL);
+	}
+	return true;
+}
+
+static void prv_hint_progress(int percent, void *context) {
+	char message[20];
+	snprintf(message, sizeof(message), "Thinking... %d%%", percent);
+	if (s_notify_layer != NULL) {
+		notify_layer_set_text(s_notify_layer, message);
+	}
+}
+
+static void prv_hint_done(char word[WORD_LENGTH], void *context) {
+	char message[] = "Try 'XXXXX'";
+	memcpy(message + 5, word, WORD_LENGTH);
+	hint_engine_destroy(s_hint);
+	s_hint = NULL;
+	prv_notify(message);
+}
+
 static void prv_update_alphabet_status(char letter, LetterStatus status) {
 	int index = letter - 'a';
 	if (status > s_game_state.alphabet_status[index]) {
@@ -311,6 +446,10 @@ static void prv_update_alphabet_status(char letter, LetterStatus status) {
 }
 
 static void prv_notify(char *message) {
+	if (s_notify_timer != NULL) {
+		app_timer_cancel(s_notify_timer);
+		s_notify_timer = NULL;
+	}
 	if (s_notify_layer != NULL) {
 		layer_remove_from_parent(s_notify_layer);
 		notify_layer_destroy(s_notify_layer);
@@ -322,3 +461,8 @@ static void prv_notify(char *message) {
 	s_notify_layer = notify_layer_create(message);
 	layer_add_child(window_get_root_layer(s_window), s_notify_layer);
 }
+
+static void prv_notify_timeout(void *context) {
+	s_notify_timer = NULL;
+	prv_notify(NULL);
+}
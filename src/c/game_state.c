@@ -0,0 +1,173 @@
+#include <pebble.h>
+#include "game_state.h"
+
+// Persists the game in progress as a bit-packed record: 5-bit letters (0 for a blank)
+// and 2-bit statuses, 29 bytes in all. Saves are write-behind: game_state_save() only
+// notes that the state may have changed, and the record is written a few seconds later,
+// or at exit, and only if it differs from what's already in flash.
+
+#define GAME_STATE_VERSION_KEY 1
+#define GAME_STATE_CONTENT_KEY 2
+#define GAME_STATE_VERSION 2
+#define GAME_STATE_FLUSH_DELAY 5000
+
+#define RECORD_BITS (16 + 3 + 3 + 2 + GUESS_LIMIT * WORD_LENGTH * 5 + 26 * 2)
+#define RECORD_SIZE ((RECORD_BITS + 7) / 8)
+
+// Version 1 wrote the in-memory struct as-is, and this must stay byte-for-byte the same
+// as it was for old saves to load.
+typedef struct {
+	int guess_number;
+	int current_char;
+	int word_number;
+	GameStatus status;
+	char guesses[GUESS_LIMIT][WORD_LENGTH];
+	LetterStatus alphabet_status[26];
+} __attribute__((packed)) GameStateV1;
+
+static GameState *s_pending;
+static AppTimer *s_flush_timer;
+static uint8_t s_written[RECORD_SIZE];
+static bool s_written_valid;
+static bool s_version_written;
+static int s_flash_writes;
+
+static void prv_pack(GameState *state, uint8_t record[RECORD_SIZE]);
+static void prv_unpack(uint8_t record[RECORD_SIZE], GameState *state);
+static void prv_migrate_v1(GameState *state);
+static void prv_flush_timer_callback(void *context);
+
+bool game_state_load(GameState *state) {
+	switch (persist_read_int(GAME_STATE_VERSION_KEY)) {
+		case 1:
+			prv_migrate_v1(state);
+			return true;
+		case GAME_STATE_VERSION:
+			if (persist_read_data(GAME_STATE_CONTENT_KEY, s_written, RECORD_SIZE) != RECORD_SIZE) {
+				return false;
+			}
+			s_written_valid = true;
+			s_version_written = true;
+			prv_unpack(s_written, state);
+			return true;
+		default:
+			return false;
+	}
+}
+
+void game_state_save(GameState *state) {
+	s_pending = state;
+	if (s_flush_timer == NULL) {
+		s_flush_timer = app_timer_register(GAME_STATE_FLUSH_DELAY, prv_flush_timer_callback, NULL);
+	}
+}
+
+void game_state_flush() {
+	if (s_flush_timer != NULL) {
+		app_timer_cancel(s_flush_timer);
+		s_flush_timer = NULL;
+	}
+	if (s_pending == NULL) {
+		return;
+	}
+	uint8_t record[RECORD_SIZE];
+	prv_pack(s_pending, record);
+	s_pending = NULL;
+	if (!s_written_valid || memcmp(record, s_written, RECORD_SIZE) != 0) {
+		persist_write_data(GAME_STATE_CONTENT_KEY, record, RECORD_SIZE);
+		++s_flash_writes;
+		memcpy(s_written, record, RECORD_SIZE);
+		s_written_valid = true;
+	}
+	// The version goes in after the record it describes, as in stat_tracker.c, so being cut
+	// off between the two never leaves it vouching for a version 1 struct.
+	if (!s_version_written) {
+		persist_write_int(GAME_STATE_VERSION_KEY, GAME_STATE_VERSION);
+		s_version_written = true;
+		++s_flash_writes;
+	}
+}
+
+void game_state_deinit() {
+	game_state_flush();
+	APP_LOG(APP_LOG_LEVEL_INFO, "Game state made %d flash writes this run.", s_flash_writes);
+}
+
+static void prv_flush_timer_callback(void *context) {
+	s_flush_timer = NULL;
+	game_state_flush();
+}
+
+static void prv_migrate_v1(GameState *state) {
+	GameStateV1 old;
+	memset(&old, 0, sizeof(old));
+	// A record of the new size means the migration got as far as writing it, but not the
+	// version after it, so there's only the version left to write.
+	if (persist_read_data(GAME_STATE_CONTENT_KEY, &old, sizeof(old)) == RECORD_SIZE) {
+		memcpy(s_written, &old, RECORD_SIZE);
+		s_written_valid = true;
+		s_version_written = false;
+		prv_unpack(s_written, state);
+		game_state_save(state);
+		return;
+	}
+	state->guess_number = old.guess_number;
+	state->current_char = old.current_char;
+	state->word_number = old.word_number;
+	state->status = old.status;
+	memcpy(state->guesses, old.guesses, sizeof(state->guesses));
+	memcpy(state->alphabet_status, old.alphabet_status, sizeof(state->alphabet_status));
+	// Nothing of the new format is in flash yet, so the next flush rewrites it.
+	game_state_save(state);
+}
+
+static void prv_put_bits(uint8_t *record, int *bit, uint32_t value, int count) {
+	for (int i = 0; i < count; ++i, ++*bit) {
+		if (value & (1 << i)) {
+			record[*bit >> 3] |= 1 << (*bit & 7);
+		}
+	}
+}
+
+static uint32_t prv_get_bits(uint8_t *record, int *bit, int count) {
+	uint32_t value = 0;
+	for (int i = 0; i < count; ++i, ++*bit) {
+		value |= (uint32_t)((record[*bit >> 3] >> (*bit & 7)) & 1) << i;
+	}
+	return value;
+}
+
+static void prv_pack(GameState *state, uint8_t record[RECORD_SIZE]) {
+	memset(record, 0, RECORD_SIZE);
+	int bit = 0;
+	prv_put_bits(record, &bit, state->word_number, 16);
+	prv_put_bits(record, &bit, state->guess_number, 3);
+	prv_put_bits(record, &bit, state->current_char, 3);
+	prv_put_bits(record, &bit, state->status, 2);
+	for (int i = 0; i < GUESS_LIMIT; ++i) {
+		for (int j = 0; j < WORD_LENGTH; ++j) {
+			char c = state->guesses[i][j];
+			prv_put_bits(record, &bit, c == 0 ? 0 : c - 'a' + 1, 5);
+		}
+	}
+	for (int i = 0; i < 26; ++i) {
+		prv_put_bits(record, &bit, state->alphabet_status[i] - LetterStatusNeutral, 2);
+	}
+}
+
+static void prv_unpack(uint8_t record[RECORD_SIZE], GameState *state) {
+	int bit = 0;
+	state->word_number = prv_get_bits(record, &bit, 16);
+	state->guess_number = prv_get_bits(record, &bit, 3);
+	state->current_char = prv_get_bits(record, &bit, 3);
+	state->status = prv_get_bits(record, &bit, 2);
+	for (int i = 0; i < GUESS_LIMIT; ++i) {
+		for (int j = 0; j < WORD_LENGTH; ++j) {
+			uint32_t letter = prv_get_bits(record, &bit, 5);
+			state->guesses[i][j] = letter == 0 ? 0 : 'a' + letter - 1;
+		}
+	}
+	for (int i = 0; i < 26; ++i) {
+		state->alphabet_status[i] = LetterStatusNeutral + prv_get_bits(record, &bit, 2);
+	}
+}
@@ -0,0 +1,22 @@
+#ifndef GAME_STATE_H
+#define GAME_STATE_H
+
+#include <pebble.h>
+#include "game.h"
+#include "model.h"
+
+typedef struct {
+	int guess_number;
+	int current_char;
+	int word_number;
+	GameStatus status;
+	char guesses[GUESS_LIMIT][WORD_LENGTH];
+	LetterStatus alphabet_status[26];
+} GameState;
+
+bool game_state_load(GameState *state);
+void game_state_save(GameState *state);
+void game_state_flush();
+void game_state_deinit();
+
+#endif
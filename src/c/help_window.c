@@ -1,6 +1,6 @@
 #include <pebble.h>
 #include "help_window.h"
-#include "word_layer.h"
+#include "board_layer.h"
 
 static Window *s_window;
 static ScrollLayer *s_scroll_layer;
@@ -8,11 +8,11 @@ static ContentIndicator *s_content_indicator;
 static Layer *s_down_arrow;
 static Layer *s_up_arrow;
 static TextLayer *s_explanation_layer;
-static WordLayer *s_example1_word;
+static BoardLayer *s_example1_word;
 static TextLayer *s_example1_label;
-static WordLayer *s_example2_word;
+static BoardLayer *s_example2_word;
 static TextLayer *s_example2_label;
-static WordLayer *s_example3_word;
+static BoardLayer *s_example3_word;
 static TextLayer *s_example3_label;
 
 static void prv_window_load(Window *window);
@@ -75,12 +75,12 @@ static void prv_window_load(Window *window) {
 		"Examples:");
 	scroll_layer_add_child(s_scroll_layer, (Layer *)s_explanation_layer);
 
-	s_example1_word = word_layer_create(GPoint(7, 685));
-	word_layer_set_letter(s_example1_word, 0, 'w', LetterStatusCorrect, true);
-	word_layer_set_letter(s_example1_word, 1, 'e', LetterStatusNeutral, true);
-	word_layer_set_letter(s_example1_word, 2, 'a', LetterStatusNeutral, true);
-	word_layer_set_letter(s_example1_word, 3, 'r', LetterStatusNeutral, true);
-	word_layer_set_letter(s_example1_word, 4, 'y', LetterStatusNeutral, true);
+	s_example1_word = board_layer_create(GPoint(7, 685), 1);
+	board_layer_set_letter(s_example1_word, 0, 0, 'w', LetterStatusCorrect, true);
+	board_layer_set_letter(s_example1_word, 0, 1, 'e', LetterStatusNeutral, true);
+	board_layer_set_letter(s_example1_word, 0, 2, 'a', LetterStatusNeutral, true);
+	board_layer_set_letter(s_example1_word, 0, 3, 'r', LetterStatusNeutral, true);
+	board_layer_set_letter(s_example1_word, 0, 4, 'y', LetterStatusNeutral, true);
 	scroll_layer_add_child(s_scroll_layer, (Layer *)s_example1_word);
 
 	s_example1_label = text_layer_create(GRect(5, 710, 134, 80));
@@ -88,12 +88,12 @@ static void prv_window_load(Window *window) {
 	text_layer_set_text(s_example1_label, "The letter W is in the word and in the correct spot.");
 	scroll_layer_add_child(s_scroll_layer, (Layer *)s_example1_label);
 
-	s_example2_word = word_layer_create(GPoint(7, 800));
-	word_layer_set_letter(s_example2_word, 0, 'p', LetterStatusNeutral, true);
-	word_layer_set_letter(s_example2_word, 1, 'i', LetterStatusWrongPosition, true);
-	word_layer_set_letter(s_example2_word, 2, 'l', LetterStatusNeutral, true);
-	word_layer_set_letter(s_example2_word, 3, 'l', LetterStatusNeutral, true);
-	word_layer_set_letter(s_example2_word, 4, 's', LetterStatusNeutral, true);
+	s_example2_word = board_layer_create(GPoint(7, 800), 1);
+	board_layer_set_letter(s_example2_word, 0, 0, 'p', LetterStatusNeutral, true);
+	board_layer_set_letter(s_example2_word, 0, 1, 'i', LetterStatusWrongPosition, true);
+	board_layer_set_letter(s_example2_word, 0, 2, 'l', LetterStatusNeutral, true);
+	board_layer_set_letter(s_example2_word, 0, 3, 'l', LetterStatusNeutral, true);
+	board_layer_set_letter(s_example2_word, 0, 4, 's', LetterStatusNeutral, true);
 	scroll_layer_add_child(s_scroll_layer, (Layer *)s_example2_word);
 
 	s_example2_label = text_layer_create(GRect(5, 825, 134, 80));
@@ -101,12 +101,12 @@ static void prv_window_load(Window *window) {
 	text_layer_set_text(s_example2_label, "The letter I is in the word but in the wrong spot.");
 	scroll_layer_add_child(s_scroll_layer, (Layer *)s_example2_label);
 
-	s_example3_word = word_layer_create(GPoint(7, 915));
-	word_layer_set_letter(s_example3_word, 0, 'v', LetterStatusNeutral, true);
-	word_layer_set_letter(s_example3_word, 1, 'a', LetterStatusNeutral, true);
-	word_layer_set_letter(s_example3_word, 2, 'g', LetterStatusNeutral, true);
-	word_layer_set_letter(s_example3_word, 3, 'u', LetterStatusNotPresent, true);
-	word_layer_set_letter(s_example3_word, 4, 'e', LetterStatusNeutral, true);
+	s_example3_word = board_layer_create(GPoint(7, 915), 1);
+	board_layer_set_letter(s_example3_word, 0, 0, 'v', LetterStatusNeutral, true);
+	board_layer_set_letter(s_example3_word, 0, 1, 'a', LetterStatusNeutral, true);
+	board_layer_set_letter(s_example3_word, 0, 2, 'g', LetterStatusNeutral, true);
+	board_layer_set_letter(s_example3_word, 0, 3, 'u', LetterStatusNotPresent, true);
+	board_layer_set_letter(s_example3_word, 0, 4, 'e', LetterStatusNeutral, true);
 	scroll_layer_add_child(s_scroll_layer, (Layer *)s_example3_word);
 
 	s_example3_label = text_layer_create(GRect(5, 940, 134, 180));
@@ -118,11 +118,11 @@ static void prv_window_load(Window *window) {
 static void prv_window_unload(Window *window) {
 	layer_destroy(s_up_arrow);
 	layer_destroy(s_down_arrow);
-	word_layer_destroy(s_example1_word);
+	board_layer_destroy(s_example1_word);
 	text_layer_destroy(s_example1_label);
-	word_layer_destroy(s_example2_word);
+	board_layer_destroy(s_example2_word);
 	text_layer_destroy(s_example2_label);
-	word_layer_destroy(s_example3_word);
+	board_layer_destroy(s_example3_word);
 	text_layer_destroy(s_example3_label);
 	text_layer_destroy(s_explanation_layer);
 	scroll_layer_destroy(s_scroll_layer);
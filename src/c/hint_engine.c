@@ -0,0 +1,143 @@
+#include <pebble.h>
+#include "hint_engine.h"
+#include "scheduler.h"
+
+// Ranks the remaining solutions as guesses by how much they're expected to tell us: for each
+// one, bucket every remaining solution by the pattern it would score, and prefer the guess
+// whose buckets have the most entropy. That's O(n^2) scoring, so it runs one guess at a time
+// as a scheduler task, and whatever is best so far is available if it gets interrupted.
+
+// Beyond this many remaining solutions, an even sample of them stands in for the rest.
+#define HINT_MAX_WORDS 500
+// Progress is reported in steps of this many percent, so the UI isn't redrawn every guess.
+#define HINT_PROGRESS_STEP 5
+
+struct HintEngine {
+	HintEngineHandlers handlers;
+	void *context;
+	SchedulerTask *task;
+	PackedWord *words;
+	int count;
+	int next;
+	int reported_percent;
+	int best;
+	uint32_t best_score;
+	uint16_t buckets[SCORE_PATTERN_COUNT];
+};
+
+static bool prv_step(void *context);
+static void prv_done(void *context);
+static uint32_t prv_rate_guess(HintEngine *engine, PackedWord guess);
+static uint32_t prv_log2_q8(uint32_t x);
+
+HintEngine *hint_engine_start(CandidateTracker *tracker, HintEngineHandlers handlers, void *context) {
+	HintEngine *engine = malloc(sizeof(HintEngine));
+	if (engine == NULL) {
+		return NULL;
+	}
+	int limit = candidate_tracker_get_count(tracker);
+	if (limit > HINT_MAX_WORDS) {
+		limit = HINT_MAX_WORDS;
+	}
+	engine->words = malloc(limit * sizeof(PackedWord));
+	if (engine->words == NULL) {
+		free(engine);
+		return NULL;
+	}
+	engine->handlers = handlers;
+	engine->context = context;
+	engine->count = candidate_tracker_get_words(tracker, engine->words, limit);
+	engine->next = 0;
+	engine->reported_percent = 0;
+	engine->best = -1;
+	engine->best_score = UINT32_MAX;
+	engine->task = scheduler_add((SchedulerTaskHandlers) {
+		.step = prv_step,
+		.done = prv_done,
+	}, engine);
+	if (engine->task == NULL) {
+		hint_engine_destroy(engine);
+		return NULL;
+	}
+	return engine;
+}
+
+bool hint_engine_get_best(HintEngine *engine, char word[WORD_LENGTH]) {
+	if (engine->best < 0) {
+		return false;
+	}
+	word_unpack(engine->words[engine->best], word);
+	return true;
+}
+
+void hint_engine_destroy(HintEngine *engine) {
+	if (engine == NULL) {
+		return;
+	}
+	scheduler_cancel(engine->task);
+	free(engine->words);
+	free(engine);
+}
+
+static bool prv_step(void *context) {
+	HintEngine *engine = context;
+	if (engine->next >= engine->count) {
+		return true;
+	}
+	uint32_t score = prv_rate_guess(engine, engine->words[engine->next]);
+	if (score < engine->best_score) {
+		engine->best_score = score;
+		engine->best = engine->next;
+	}
+	++engine->next;
+
+	int percent = engine->next * 100 / engine->count;
+	if (percent >= engine->reported_percent + HINT_PROGRESS_STEP && engine->next < engine->count) {
+		engine->reported_percent = percent;
+		if (engine->handlers.progress != NULL) {
+			engine->handlers.progress(percent, engine->context);
+		}
+	}
+	return engine->next >= engine->count;
+}
+
+static void prv_done(void *context) {
+	HintEngine *engine = context;
+	engine->task = NULL;
+	char word[WORD_LENGTH];
+	if (engine->handlers.done != NULL && hint_engine_get_best(engine, word)) {
+		engine->handlers.done(word, engine->context);
+	}
+}
+
+// Returns the sum of n log2 n over the pattern buckets, in 1/256ths. Entropy is
+// log2(count) minus this over count, so a lower score means a more informative guess.
+static uint32_t prv_rate_guess(HintEngine *engine, PackedWord guess) {
+	memset(engine->buckets, 0, sizeof(engine->buckets));
+	for (int i = 0; i < engine->count; ++i) {
+		++engine->buckets[score_packed(guess, engine->words[i])];
+	}
+	uint32_t score = 0;
+	for (int i = 0; i < SCORE_PATTERN_COUNT; ++i) {
+		if (engine->buckets[i] > 1) {
+			score += engine->buckets[i] * prv_log2_q8(engine->buckets[i]);
+		}
+	}
+	return score;
+}
+
+// log2(x) in 8.8 fixed point, by repeated squaring of the mantissa. There's no libm here.
+static uint32_t prv_log2_q8(uint32_t x) {
+	int exponent = 31 - __builtin_clz(x);
+	// Mantissa in [1, 2) as 1.15 fixed point, so that squaring it fits in 32 bits.
+	uint32_t mantissa = exponent > 15 ? x >> (exponent - 15) : x << (15 - exponent);
+	uint32_t result = exponent << 8;
+	for (int bit = 7; bit >= 0; --bit) {
+		mantissa = (mantissa * mantissa) >> 15;
+		if (mantissa >= (1 << 16)) {
+			mantissa >>= 1;
+			result |= 1 << bit;
+		}
+	}
+	return result;
+}
@@ -0,0 +1,23 @@
+#ifndef HINT_ENGINE_H
+#define HINT_ENGINE_H
+
+#include <pebble.h>
+#include "model.h"
+#include "candidate_tracker.h"
+
+struct HintEngine;
+typedef struct HintEngine HintEngine;
+
+typedef void (*HintEngineProgressHandler)(int percent, void *context);
+typedef void (*HintEngineDoneHandler)(char word[WORD_LENGTH], void *context);
+
+typedef struct {
+	HintEngineProgressHandler progress;
+	HintEngineDoneHandler done;
+} HintEngineHandlers;
+
+HintEngine *hint_engine_start(CandidateTracker *tracker, HintEngineHandlers handlers, void *context);
+bool hint_engine_get_best(HintEngine *engine, char word[WORD_LENGTH]);
+void hint_engine_destroy(HintEngine *engine);
+
+#endif
@@ -2,10 +2,15 @@
 #include <pebble-events/pebble-events.h>
 
 #include "model.h"
+#include "calendar.h"
+#include "dictionary.h"
 #include "title_layer.h"
 #include "game.h"
 #include "stat_window.h"
 #include "help_window.h"
+#include "game_state.h"
+#include "tile.h"
+#include "share_code.h"
 
 #define MENU_OPTIONS 3
 
@@ -74,6 +79,7 @@ static void prv_window_unload(Window *window) {
 }
 
 static void prv_init() {
+  dictionary_init();
   s_window = window_create();
   window_set_window_handlers(s_window, (WindowHandlers) {
     .load = prv_window_load,
@@ -86,10 +92,16 @@ static void prv_init() {
 
 static void prv_deinit() {
   events_tick_timer_service_unsubscribe(s_tick_timer_handle);
+  game_state_deinit();
+  share_code_deinit();
+  tile_deinit();
+  dictionary_deinit();
 }
 
 static void prv_handle_day_change(struct tm *tick_time, TimeUnits units_changed) {
   if (units_changed & DAY_UNIT) {
+    // Clock and timezone changes arrive as ticks with every unit changed, so this covers those too.
+    calendar_invalidate();
     if (s_wordle_number != wordle_number()) {
       window_stack_pop_all(true);
     }
@@ -1,178 +1,137 @@
 #include <pebble.h>
 #include "model.h"
+#include "dictionary.h"
+#include "calendar.h"
 
-static short prv_words_in_file(ResHandle file);
-static short prv_accepted_words();
-static void prv_accepted_at_index(int index, char buffer[WORD_LENGTH]);
-static int prv_compare_words(char a[WORD_LENGTH], char b[WORD_LENGTH]);
-static int prv_letter_count(char word[WORD_LENGTH], int limit, char letter);
-static int prv_correct_letter_count(char word[WORD_LENGTH], char expected[WORD_LENGTH], char letter);
+#define LETTER_BITS 5
+#define LETTER_MASK 0x1F
+// The lowest and highest bit of every letter field in a PackedWord.
+#define FIELD_LOW_BITS 0x00108421
+#define FIELD_HIGH_BITS (FIELD_LOW_BITS << (LETTER_BITS - 1))
+#define FIELD_HIGH_BIT(i) (1 << ((i) * LETTER_BITS + LETTER_BITS - 1))
+
+static uint8_t prv_score(char word[WORD_LENGTH], char expected[WORD_LENGTH], LetterStatus result[WORD_LENGTH]);
 static void prv_word_for_day(int day, char word[WORD_LENGTH]);
 static void prv_word_at_index(ResHandle file, int index, char buffer[WORD_LENGTH]);
 
 bool score_word(char word[WORD_LENGTH], char expected[WORD_LENGTH], LetterStatus result[WORD_LENGTH]) {
-	bool correct = true;
+	return prv_score(word, expected, result) == SCORE_PATTERN_CORRECT;
+}
 
-	for (int i = 0; i < WORD_LENGTH; ++i) {
-		if (word[i] == expected[i]) {
-			result[i] = LetterStatusCorrect;
-			continue;
-		}
-		correct = false;
-		if (prv_letter_count(expected, WORD_LENGTH, word[i]) - prv_correct_letter_count(word, expected, word[i]) > prv_letter_count(word, i, word[i])) {
-			result[i] = LetterStatusWrongPosition;
-		} else {
-			result[i] = LetterStatusNotPresent;
-		}
-	}
+uint8_t score_word_packed(char word[WORD_LENGTH], char expected[WORD_LENGTH]) {
+	return prv_score(word, expected, NULL);
+}
 
-	return correct;
+void score_pattern_unpack(uint8_t pattern, LetterStatus result[WORD_LENGTH]) {
+	for (int i = WORD_LENGTH - 1; i >= 0; --i) {
+		result[i] = LetterStatusNotPresent + pattern % 3;
+		pattern /= 3;
+	}
 }
 
-bool is_valid_word(char word[WORD_LENGTH]) {
-	int total_words = prv_accepted_words();
-	int pos = total_words / 2;
-	int lower_bound = 0;
-	int upper_bound = total_words - 1;
-
-	while (lower_bound <= upper_bound) {
-		char comp_word[WORD_LENGTH];
-		prv_accepted_at_index(pos, comp_word);
-		int comp = prv_compare_words(word, comp_word);
-		if (comp == 0) {
-			return true;
-		}
-		if (comp < 0) {
-			upper_bound = pos - 1;
-			pos = (lower_bound + upper_bound) / 2;
-		} else {
-			lower_bound = pos + 1;
-			pos = (lower_bound + upper_bound) / 2;
-		}
+PackedWord word_pack(char word[WORD_LENGTH]) {
+	PackedWord packed = 0;
+	for (int i = WORD_LENGTH - 1; i >= 0; --i) {
+		packed = (packed << LETTER_BITS) | (word[i] - 'a');
 	}
+	return packed;
+}
 
-	return false;
+void word_unpack(PackedWord packed, char word[WORD_LENGTH]) {
+	for (int i = 0; i < WORD_LENGTH; ++i) {
+		word[i] = 'a' + ((packed >> (i * LETTER_BITS)) & LETTER_MASK);
+	}
 }
 
-void word_of_the_day(char word[WORD_LENGTH]) {
-	prv_word_for_day(wordle_number(), word);
+// Sets the high bit of every letter field where word and expected agree. The low four bits
+// of each field can't carry out of it, so this is exact, not just a likely-zero test.
+static uint32_t prv_green_fields(PackedWord word, PackedWord expected) {
+	uint32_t diff = word ^ expected;
+	uint32_t low = FIELD_HIGH_BITS - FIELD_LOW_BITS;
+	uint32_t nonzero = (((diff & low) + low) | diff) & FIELD_HIGH_BITS;
+	return nonzero ^ FIELD_HIGH_BITS;
 }
 
-static int prv_compare_tm(struct tm *a, struct tm *b) {
-	if (a->tm_year > b->tm_year) {
-		return 1;
-	} else if (a->tm_year < b->tm_year) {
-		return -1;
-	}
-	if (a->tm_mon > b->tm_mon) {
-		return 1;
-	} else if(a->tm_mon < b->tm_mon) {
-		return -1;
+// Same result as score_word_packed(). Each non-green guess letter is broadcast to every
+// field and compared against expected in one go; it's yellow if that finds an expected
+// letter that isn't green and hasn't already been claimed by an earlier yellow.
+uint8_t score_packed(PackedWord word, PackedWord expected) {
+	uint32_t green = prv_green_fields(word, expected);
+	if (green == FIELD_HIGH_BITS) {
+		return SCORE_PATTERN_CORRECT;
 	}
-	if (a->tm_mday > b->tm_mday) {
-		return 1;
-	} else if(a->tm_mday < b->tm_mday) {
-		return -1;
-	}
-	if (a->tm_hour > b->tm_hour) {
-		return 1;
-	} else if (a->tm_hour < b->tm_hour) {
-		return -1;
-	}
-	if (a->tm_min > b->tm_min) {
-		return 1;
-	} else if(a->tm_min < b->tm_min) {
-		return -1;
+
+	uint32_t taken = green;
+	uint8_t pattern = 0;
+	for (int i = 0; i < WORD_LENGTH; ++i) {
+		int digit = 0;
+		if (green & FIELD_HIGH_BIT(i)) {
+			digit = 2;
+		} else {
+			uint32_t letter = (word >> (i * LETTER_BITS)) & LETTER_MASK;
+			uint32_t available = prv_green_fields(letter * FIELD_LOW_BITS, expected) & ~taken;
+			if (available) {
+				taken |= available & -available;
+				digit = 1;
+			}
+		}
+		pattern = pattern * 3 + digit;
 	}
-	return 0;
+	return pattern;
 }
 
-static time_t prv_tm_diff(struct tm *a, struct tm *b) {
-	int compare = prv_compare_tm(a, b);
-	if (compare == 0) {
-		return 0;
+void score_packed_many(PackedWord word, const PackedWord *expected, int count, uint8_t *patterns) {
+	for (int i = 0; i < count; ++i) {
+		patterns[i] = score_packed(word, expected[i]);
 	}
-	if (compare < 0) {
-		struct tm *temp = a;
-		a = b;
-		b = temp;
-	}
-	int difference = (a->tm_hour - b->tm_hour) * 3600 + (a->tm_min - b->tm_min) * 60;
-	if(a->tm_mday != b->tm_mday) {
-		difference += 86400;
-	}
-	if (compare > 0) {
-		return difference;
-	}
-	return -difference;
 }
 
-static time_t prv_timezone_offset() {
-	time_t now = time(NULL);
-	struct tm local = *localtime(&now);
-	struct tm utc = *gmtime(&now);
-	return prv_tm_diff(&local, &utc);
+bool is_valid_word(char word[WORD_LENGTH]) {
+	return dictionary_contains(word);
+}
+
+void word_of_the_day(char word[WORD_LENGTH]) {
+	prv_word_for_day(wordle_number(), word);
 }
 
 int wordle_number() {
-	// Wordle day 0 is June 19th, 2021 in the user's local time
-	time_t epoch_unixtime = 1624060800;
-
-	time_t now = time(NULL);
-	time_t tz_offset = prv_timezone_offset();
-	now += tz_offset;
-	int days = (int)(now - epoch_unixtime) / 86400;
-	return days;
+	return calendar_get_day();
 }
 
 static void prv_word_for_day(int day, char word[WORD_LENGTH]) {
 	prv_word_at_index(resource_get_handle(RESOURCE_ID_SOLUTION_WORDS), day, word);
 }
 
-static int prv_letter_count(char word[WORD_LENGTH], int limit, char letter) {
-	int count = 0;
-	for (int i = 0; i < limit; ++i) {
-		if (word[i] == letter) {
-			++count;
+// Greens first, counting the expected letters they don't use up; then each remaining guess
+// letter, left to right, is yellow if there's one of it left to claim. Builds the packed
+// pattern as it goes, and fills in result too unless it's NULL.
+static uint8_t prv_score(char word[WORD_LENGTH], char expected[WORD_LENGTH], LetterStatus result[WORD_LENGTH]) {
+	uint8_t unmatched[26] = {0};
+	for (int i = 0; i < WORD_LENGTH; ++i) {
+		if (word[i] != expected[i]) {
+			++unmatched[expected[i] - 'a'];
 		}
 	}
-	return count;
-}
 
-static int prv_correct_letter_count(char word[WORD_LENGTH], char expected[WORD_LENGTH], char letter) {
-	int count = 0;
+	uint8_t pattern = 0;
 	for (int i = 0; i < WORD_LENGTH; ++i) {
-		if (expected[i] == letter && word[i] == letter) {
-			++count;
+		LetterStatus status;
+		if (word[i] == expected[i]) {
+			status = LetterStatusCorrect;
+		} else if (unmatched[word[i] - 'a'] > 0) {
+			--unmatched[word[i] - 'a'];
+			status = LetterStatusWrongPosition;
+		} else {
+			status = LetterStatusNotPresent;
+		}
+		pattern = pattern * 3 + (status - LetterStatusNotPresent);
+		if (result != NULL) {
+			result[i] = status;
 		}
 	}
-	return count;
+	return pattern;
 }
 
 static void prv_word_at_index(ResHandle file, int index, char buffer[WORD_LENGTH]) {
 	resource_load_byte_range(file, index * WORD_LENGTH, (uint8_t*)buffer, WORD_LENGTH);
-}
-
-static short prv_words_in_file(ResHandle file) {
-	return resource_size(file) / WORD_LENGTH;
-}
-
-static short prv_accepted_words() {
-	return prv_words_in_file(resource_get_handle(RESOURCE_ID_ACCEPTABLE_WORDS));
-}
-
-static void prv_accepted_at_index(int index, char buffer[WORD_LENGTH]) {
-	prv_word_at_index(resource_get_handle(RESOURCE_ID_ACCEPTABLE_WORDS), index, buffer);
-}
-
-static int prv_compare_words(char a[WORD_LENGTH], char b[WORD_LENGTH]) {
-	for (int i = 0; i < WORD_LENGTH; ++i) {
-		if (a[i] < b[i]) {
-			return -1;
-		}
-		if (a[i] > b[i]) {
-			return 1;
-		}
-	}
-	return 0;
 }
\ No newline at end of file
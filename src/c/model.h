@@ -12,8 +12,23 @@ enum LetterStatus {
 };
 typedef enum LetterStatus LetterStatus;
 
+// A scored guess packed into one byte: one base-3 digit per letter, first letter most
+// significant, with 0 for LetterStatusNotPresent, 1 for WrongPosition and 2 for Correct.
+#define SCORE_PATTERN_COUNT 243
+#define SCORE_PATTERN_CORRECT (SCORE_PATTERN_COUNT - 1)
+
+// A word packed five bits per letter ('a' is 0), first letter in the lowest bits, for bulk
+// work like scoring one guess against every solution.
+typedef uint32_t PackedWord;
+
 bool is_valid_word(char word[WORD_LENGTH]);
 bool score_word(char word[WORD_LENGTH], char expected[WORD_LENGTH], LetterStatus result[WORD_LENGTH]);
+uint8_t score_word_packed(char word[WORD_LENGTH], char expected[WORD_LENGTH]);
+void score_pattern_unpack(uint8_t pattern, LetterStatus result[WORD_LENGTH]);
+PackedWord word_pack(char word[WORD_LENGTH]);
+void word_unpack(PackedWord packed, char word[WORD_LENGTH]);
+uint8_t score_packed(PackedWord word, PackedWord expected);
+void score_packed_many(PackedWord word, const PackedWord *expected, int count, uint8_t *patterns);
 void word_of_the_day(char word[WORD_LENGTH]);
 int wordle_number();
 
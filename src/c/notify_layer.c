@@ -4,6 +4,7 @@
 
 typedef struct {
 	char *message;
+	size_t capacity;
 } NotifyLayerData;
 
 static GFont s_font;
@@ -19,7 +20,8 @@ NotifyLayer *notify_layer_create(char *message) {
 	Layer *layer = layer_create_with_data(GRect((144 - size.w) / 2, (168 - size.h) / 2, size.w, size.h), sizeof(NotifyLayerData));
 	layer_set_update_proc(layer, prv_update_proc);
 	NotifyLayerData *data = layer_get_data(layer);
-	data->message = malloc(strlen(message) + 1);
+	data->capacity = strlen(message) + 1;
+	data->message = malloc(data->capacity);
 	strcpy(data->message, message);
 	return layer;
 }
@@ -30,6 +32,21 @@ void notify_layer_destroy(NotifyLayer *layer) {
 	layer_destroy(layer);
 }
 
+void notify_layer_set_text(NotifyLayer *layer, char *message) {
+	NotifyLayerData *data = layer_get_data(layer);
+	size_t length = strlen(message) + 1;
+	if (length > data->capacity) {
+		char *grown = realloc(data->message, length);
+		if (grown == NULL) {
+			return;
+		}
+		data->message = grown;
+		data->capacity = length;
+	}
+	strcpy(data->message, message);
+	layer_mark_dirty(layer);
+}
+
 static void prv_update_proc(Layer *layer, GContext *ctx) {
 	NotifyLayerData *data = layer_get_data(layer);
 	GRect bounds = layer_get_bounds(layer);
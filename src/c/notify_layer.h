@@ -5,5 +5,8 @@ typedef Layer NotifyLayer;
 
 NotifyLayer *notify_layer_create(char *message);
 void notify_layer_destroy(NotifyLayer *layer);
+// Changes the message without resizing the box, so it should be no wider than the one the
+// layer was created with.
+void notify_layer_set_text(NotifyLayer *layer, char *message);
 
 #endif
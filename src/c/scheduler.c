@@ -0,0 +1,121 @@
+#include <pebble.h>
+#include "scheduler.h"
+
+// Runs long jobs off the click path. Queued tasks are stepped round-robin for up to
+// SCHEDULER_SLICE_MS at a time, and each slice ends by posting a zero-delay timer for the
+// next one. Pebble doesn't let us peek at its event queue, but anything already waiting in
+// it (clicks, animation frames) is handled before that timer fires, so keeping slices to
+// about a frame's length is what keeps the UI responsive.
+
+#define SCHEDULER_SLICE_MS 25
+
+struct SchedulerTask {
+	SchedulerTaskHandlers handlers;
+	void *context;
+	bool cancelled;
+	SchedulerTask *next;
+};
+
+static SchedulerTask *s_queue;
+static SchedulerTask *s_running;
+static AppTimer *s_timer;
+
+static void prv_run_slice(void *context);
+static void prv_schedule();
+static void prv_append(SchedulerTask *task);
+static void prv_remove(SchedulerTask *task);
+static int prv_elapsed_ms(time_t start_s, uint16_t start_ms);
+
+SchedulerTask *scheduler_add(SchedulerTaskHandlers handlers, void *context) {
+	SchedulerTask *task = malloc(sizeof(SchedulerTask));
+	if (task == NULL) {
+		return NULL;
+	}
+	*task = (SchedulerTask) {
+		.handlers = handlers,
+		.context = context,
+	};
+	prv_append(task);
+	prv_schedule();
+	return task;
+}
+
+void scheduler_cancel(SchedulerTask *task) {
+	if (task == NULL) {
+		return;
+	}
+	// A task cancelling itself from its own step is cleaned up once the step returns.
+	if (task == s_running) {
+		task->cancelled = true;
+		return;
+	}
+	prv_remove(task);
+	free(task);
+	if (s_queue == NULL && s_timer != NULL) {
+		app_timer_cancel(s_timer);
+		s_timer = NULL;
+	}
+}
+
+static void prv_run_slice(void *context) {
+	s_timer = NULL;
+	time_t start_s;
+	uint16_t start_ms;
+	time_ms(&start_s, &start_ms);
+
+	while (s_queue != NULL && prv_elapsed_ms(start_s, start_ms) < SCHEDULER_SLICE_MS) {
+		SchedulerTask *task = s_queue;
+		prv_remove(task);
+		s_running = task;
+		bool finished = false;
+		do {
+			finished = task->handlers.step(task->context);
+		} while (!finished && !task->cancelled && prv_elapsed_ms(start_s, start_ms) < SCHEDULER_SLICE_MS);
+		s_running = NULL;
+
+		if (task->cancelled) {
+			free(task);
+		} else if (finished) {
+			SchedulerTaskDone done = task->handlers.done;
+			void *task_context = task->context;
+			free(task);
+			if (done != NULL) {
+				done(task_context);
+			}
+		} else {
+			prv_append(task);
+		}
+	}
+	prv_schedule();
+}
+
+static void prv_schedule() {
+	if (s_queue != NULL && s_timer == NULL) {
+		s_timer = app_timer_register(0, prv_run_slice, NULL);
+	}
+}
+
+static void prv_append(SchedulerTask *task) {
+	task->next = NULL;
+	SchedulerTask **link = &s_queue;
+	while (*link != NULL) {
+		link = &(*link)->next;
+	}
+	*link = task;
+}
+
+static void prv_remove(SchedulerTask *task) {
+	for (SchedulerTask **link = &s_queue; *link != NULL; link = &(*link)->next) {
+		if (*link == task) {
+			*link = task->next;
+			return;
+		}
+	}
+}
+
+static int prv_elapsed_ms(time_t start_s, uint16_t start_ms) {
+	time_t now_s;
+	uint16_t now_ms;
+	time_ms(&now_s, &now_ms);
+	return (now_s - start_s) * 1000 + now_ms - start_ms;
+}
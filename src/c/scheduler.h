@@ -0,0 +1,22 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <pebble.h>
+
+struct SchedulerTask;
+typedef struct SchedulerTask SchedulerTask;
+
+// Does a small piece of the task's work, returning true once there's nothing left to do.
+typedef bool (*SchedulerTaskStep)(void *context);
+// Called once the task has finished, after it has left the queue.
+typedef void (*SchedulerTaskDone)(void *context);
+
+typedef struct {
+	SchedulerTaskStep step;
+	SchedulerTaskDone done;
+} SchedulerTaskHandlers;
+
+SchedulerTask *scheduler_add(SchedulerTaskHandlers handlers, void *context);
+void scheduler_cancel(SchedulerTask *task);
+
+#endif
@@ -0,0 +1,179 @@
+#include <pebble.h>
+#include "share_code.h"
+#include "scheduler.h"
+
+// Builds the share URL for a finished game and encodes it as a QR code. Encoding tries every
+// mask to find the most legible one, which is too slow to do as the stats window opens, so it's
+// started in the background when the game ends and the matrix is kept in flash, tagged with the
+// day it's for. The stats window just loads it, and only encodes it itself if that fails.
+
+#define SHARE_CODE_KEY 8
+
+// This needs to be in ALL CAPS so we can use the more efficient
+// QR encoding.
+#define URL_PREFIX "HTTPS://WORD.KTBY.IO/"
+#define PATH_ALPHABET "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ$*+-:"
+#define PATH_BASE (sizeof(PATH_ALPHABET) - 1)
+// 41^12 is more than the largest path value, a little under 2^64.
+#define PATH_LENGTH 12
+#define URL_LENGTH (sizeof(URL_PREFIX) + PATH_LENGTH)
+
+typedef struct {
+	int16_t wordle_num;
+	uint8_t qrcode[SHARE_CODE_SIZE];
+} __attribute__((packed)) ShareCodeRecord;
+
+typedef struct {
+	SchedulerTask *task;
+	int wordle_num;
+	char url[URL_LENGTH];
+	bool encoded;
+	bool valid;
+	uint8_t qrcode[SHARE_CODE_SIZE];
+} ShareCodeJob;
+
+static ShareCodeJob *s_job;
+
+static bool prv_step(void *context);
+static void prv_done(void *context);
+static void prv_finish_job();
+static bool prv_encode(char url[URL_LENGTH], uint8_t qrcode[SHARE_CODE_SIZE]);
+static void prv_save(int wordle_num, uint8_t qrcode[SHARE_CODE_SIZE]);
+static void prv_build_url(int wordle_num, LetterStatus guesses[GUESS_LIMIT][WORD_LENGTH], char url[URL_LENGTH]);
+
+void share_code_precompute(int wordle_num, LetterStatus guesses[GUESS_LIMIT][WORD_LENGTH]) {
+	if (s_job != NULL) {
+		scheduler_cancel(s_job->task);
+		free(s_job);
+	}
+	s_job = malloc(sizeof(ShareCodeJob));
+	if (s_job == NULL) {
+		return;
+	}
+	s_job->wordle_num = wordle_num;
+	prv_build_url(wordle_num, guesses, s_job->url);
+	s_job->encoded = false;
+	s_job->valid = false;
+	s_job->task = scheduler_add((SchedulerTaskHandlers) {
+		.step = prv_step,
+		.done = prv_done,
+	}, s_job);
+	if (s_job->task == NULL) {
+		free(s_job);
+		s_job = NULL;
+	}
+}
+
+bool share_code_load(int wordle_num, uint8_t qrcode[SHARE_CODE_SIZE]) {
+	// If the stats window beats the background encode, it finishes it here rather than
+	// starting over.
+	prv_finish_job();
+	ShareCodeRecord record;
+	if (persist_read_data(SHARE_CODE_KEY, &record, sizeof(record)) != sizeof(record) || record.wordle_num != wordle_num) {
+		return false;
+	}
+	memcpy(qrcode, record.qrcode, SHARE_CODE_SIZE);
+	return true;
+}
+
+bool share_code_encode(int wordle_num, LetterStatus guesses[GUESS_LIMIT][WORD_LENGTH], uint8_t qrcode[SHARE_CODE_SIZE]) {
+	char url[URL_LENGTH];
+	prv_build_url(wordle_num, guesses, url);
+	if (!prv_encode(url, qrcode)) {
+		return false;
+	}
+	prv_save(wordle_num, qrcode);
+	return true;
+}
+
+void share_code_deinit() {
+	prv_finish_job();
+}
+
+// qrcodegen doesn't expose its mask scoring, so the encode itself is a single step.
+static bool prv_step(void *context) {
+	ShareCodeJob *job = context;
+	job->valid = prv_encode(job->url, job->qrcode);
+	job->encoded = true;
+	return true;
+}
+
+static void prv_done(void *context) {
+	ShareCodeJob *job = context;
+	if (job->valid) {
+		prv_save(job->wordle_num, job->qrcode);
+	}
+	free(job);
+	s_job = NULL;
+}
+
+static void prv_finish_job() {
+	if (s_job == NULL) {
+		return;
+	}
+	scheduler_cancel(s_job->task);
+	if (!s_job->encoded) {
+		prv_step(s_job);
+	}
+	prv_done(s_job);
+}
+
+static bool prv_encode(char url[URL_LENGTH], uint8_t qrcode[SHARE_CODE_SIZE]) {
+	uint8_t *temp_buffer = malloc(SHARE_CODE_SIZE);
+	if (temp_buffer == NULL) {
+		return false;
+	}
+	// The smallest version the URL fits in, at the highest error correction level that
+	// still fits in that version.
+	struct qrcodegen_Segment seg;
+	seg = qrcodegen_makeAlphanumeric(url, temp_buffer);
+	bool result = qrcodegen_encodeSegmentsAdvanced(&seg, 1, qrcodegen_Ecc_LOW, qrcodegen_VERSION_MIN, qrcodegen_VERSION_MAX,
+			qrcodegen_Mask_AUTO, true, temp_buffer, qrcode);
+	free(temp_buffer);
+	return result;
+}
+
+static void prv_save(int wordle_num, uint8_t qrcode[SHARE_CODE_SIZE]) {
+	ShareCodeRecord record;
+	record.wordle_num = wordle_num;
+	memcpy(record.qrcode, qrcode, SHARE_CODE_SIZE);
+	persist_write_data(SHARE_CODE_KEY, &record, sizeof(record));
+}
+
+// The path is the whole game as one number: each scored row is a base-3 pattern (as in
+// model.h) written in bijective base 243, so the row count needs no digit of its own, first
+// row least significant, and the wordle number below that in the low 16 bits. Six rows
+// still fit in 64 bits. It's written in base 41, using the QR alphanumeric characters that
+// are safe in a URL path, and padded to an even length so the emoji site can tell it from
+// the old format, which always has an odd number of characters.
+static void prv_build_url(int wordle_num, LetterStatus guesses[GUESS_LIMIT][WORD_LENGTH], char url[URL_LENGTH]) {
+	uint64_t rows = 0;
+	for (int i = GUESS_LIMIT - 1; i >= 0; --i) {
+		if (guesses[i][0] == LetterStatusNeutral) {
+			continue;
+		}
+		int pattern = 0;
+		for (int j = 0; j < WORD_LENGTH; ++j) {
+			pattern = pattern * 3 + guesses[i][j] - LetterStatusNotPresent;
+		}
+		rows = rows * SCORE_PATTERN_COUNT + pattern + 1;
+	}
+	uint64_t value = (rows << 16) | (uint16_t)wordle_num;
+
+	char digits[PATH_LENGTH];
+	int length = 0;
+	do {
+		digits[length++] = PATH_ALPHABET[value % PATH_BASE];
+		value /= PATH_BASE;
+	} while (value > 0);
+	if (length % 2 != 0) {
+		digits[length++] = PATH_ALPHABET[0];
+	}
+
+	strcpy(url, URL_PREFIX);
+	char *path = url + sizeof(URL_PREFIX) - 1;
+	for (int i = 0; i < length; ++i) {
+		path[i] = digits[length - 1 - i];
+	}
+	path[length] = '\0';
+}
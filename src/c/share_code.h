@@ -0,0 +1,16 @@
+#ifndef SHARE_CODE_H
+#define SHARE_CODE_H
+
+#include <pebble.h>
+#include "model.h"
+#include "game.h"
+#include "vendor/qrcodegen.h"
+
+#define SHARE_CODE_SIZE qrcodegen_BUFFER_LEN_MAX
+
+void share_code_precompute(int wordle_num, LetterStatus guesses[GUESS_LIMIT][WORD_LENGTH]);
+bool share_code_load(int wordle_num, uint8_t qrcode[SHARE_CODE_SIZE]);
+bool share_code_encode(int wordle_num, LetterStatus guesses[GUESS_LIMIT][WORD_LENGTH], uint8_t qrcode[SHARE_CODE_SIZE]);
+void share_code_deinit();
+
+#endif
@@ -1,102 +1,178 @@
 #include <pebble.h>
 #include "share_layer.h"
-#include "game.h"
-#include "model.h"
+#include "share_code.h"
 #include "vendor/qrcodegen.h"
 
-// This needs to be in ALL CAPS so we can use the more efficient
-// QR encoding.
-#define URL_PREFIX "HTTPS://WORD.KTBY.IO/"
-
+// The code is drawn as large as it fits, at a whole number of pixels per module. With
+// SHARE_CODE_BITMAP (set per platform in the wscript), it's drawn once into a 1-bit bitmap
+// that the update proc just blits. Without it, only the module matrix is kept, and the update
+// proc writes the modules straight into the frame buffer: each module row is drawn once and
+// copied down for the rest of its pixel rows.
 typedef struct {
-	bool has_qr_code;
-	uint8_t qrcode[qrcodegen_BUFFER_LEN_FOR_VERSION(2)];
+#ifdef SHARE_CODE_BITMAP
+	GBitmap *qr_bitmap;
+#else
+	bool has_code;
+	uint8_t qrcode[SHARE_CODE_SIZE];
+#endif
 } ShareLayerData;
 
-static void prv_silly_number_encoding(int number, char* buffer);
-static void prv_silly_short_encoding(uint16_t word, char* buffer);
 static void prv_update_proc(Layer *layer, GContext *ctx);
-static bool prv_generate_alphanumeric_qr(char *text, uint8_t *qrcode);
+#ifdef SHARE_CODE_BITMAP
+static GBitmap *prv_render_qr(uint8_t *qrcode, GSize size);
+#else
+static void prv_stream_qr(Layer *layer, GContext *ctx, uint8_t *qrcode);
+static void prv_draw_row(uint8_t *row, bool one_bit, int x0, int x1, int left, int ppm, uint8_t *qrcode, int module_y);
+static void prv_copy_row(uint8_t *row, uint8_t *source, bool one_bit, int x0, int x1);
+#endif
 
 ShareLayer *share_layer_create(GRect frame) {
 	Layer *layer = layer_create_with_data(frame, sizeof(ShareLayerData));
+	ShareLayerData *data = layer_get_data(layer);
+#ifdef SHARE_CODE_BITMAP
+	data->qr_bitmap = NULL;
+#else
+	data->has_code = false;
+#endif
 	layer_set_update_proc(layer, prv_update_proc);
 	return layer;
 }
 
-void share_layer_set_game_state(ShareLayer *layer, int wordle_num, LetterStatus guesses[GUESS_LIMIT][WORD_LENGTH]) {
+void share_layer_set_qr_code(ShareLayer *layer, uint8_t *qrcode) {
 	ShareLayerData *data = layer_get_data(layer);
-	char path[14];
-	memset(path, 0, sizeof(path));
-	prv_silly_number_encoding(wordle_num, path);
-	for (int i = 0; i < GUESS_LIMIT; ++i) {
-		if (guesses[i][0] == LetterStatusNeutral) {
-			break;
-		}
-		uint16_t guess = 0;
-		for (int j = 0; j < WORD_LENGTH; ++j) {
-			guess |= ((uint8_t)guesses[i][j] << (j * 2));
-		}
-		prv_silly_short_encoding(guess, path + 3 + i*2);
+#ifdef SHARE_CODE_BITMAP
+	if (data->qr_bitmap != NULL) {
+		gbitmap_destroy(data->qr_bitmap);
 	}
-	size_t url_length = sizeof(URL_PREFIX) + strlen(path);
-	char* url = malloc(url_length);
-	snprintf(url, url_length, URL_PREFIX "%s", path);
-
-	data->has_qr_code = prv_generate_alphanumeric_qr(url, data->qrcode);
-	free(url);
+	data->qr_bitmap = prv_render_qr(qrcode, layer_get_bounds(layer).size);
+#else
+	memcpy(data->qrcode, qrcode, SHARE_CODE_SIZE);
+	data->has_code = true;
+#endif
+	layer_mark_dirty(layer);
 }
 
 void share_layer_destroy(ShareLayer *layer) {
+#ifdef SHARE_CODE_BITMAP
+	ShareLayerData *data = layer_get_data(layer);
+	if (data->qr_bitmap != NULL) {
+		gbitmap_destroy(data->qr_bitmap);
+	}
+#endif
 	layer_destroy(layer);
 }
 
-static bool prv_generate_alphanumeric_qr(char *text, uint8_t *qrcode) {
-	uint8_t *temp_buffer = malloc(qrcodegen_BUFFER_LEN_FOR_VERSION(2));
-	struct qrcodegen_Segment seg;
-	seg = qrcodegen_makeAlphanumeric(text, temp_buffer);
-	bool result = qrcodegen_encodeSegmentsAdvanced(&seg, 1, qrcodegen_Ecc_MEDIUM, 2, 2, qrcodegen_Mask_AUTO, true, temp_buffer, qrcode);
-	free(temp_buffer);
-	return result;
+static void prv_update_proc(Layer *layer, GContext *ctx) {
+	ShareLayerData *data = layer_get_data(layer);
+	GRect bounds = layer_get_bounds(layer);
+#ifdef SHARE_CODE_BITMAP
+	if (data->qr_bitmap == NULL) {
+		graphics_context_set_fill_color(ctx, GColorRed);
+		graphics_fill_rect(ctx, bounds, 0, GCornerNone);
+		return;
+	}
+	GSize size = gbitmap_get_bounds(data->qr_bitmap).size;
+	graphics_context_set_compositing_mode(ctx, GCompOpAssign);
+	graphics_draw_bitmap_in_rect(ctx, data->qr_bitmap, GRect((bounds.size.w - size.w) / 2, (bounds.size.h - size.h) / 2, size.w, size.h));
+#else
+	if (!data->has_code) {
+		graphics_context_set_fill_color(ctx, GColorRed);
+		graphics_fill_rect(ctx, bounds, 0, GCornerNone);
+		return;
+	}
+	prv_stream_qr(layer, ctx, data->qrcode);
+#endif
 }
 
-static void prv_silly_number_encoding(int number, char* buffer) {
-	const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
-	buffer[0] = alphabet[number / (36 * 36)];
-	buffer[1] = alphabet[(number % (36 * 36)) / 36];
-	buffer[2] = alphabet[number % 36];
+#ifdef SHARE_CODE_BITMAP
+// As large as will fit in size, with set bits (white in a 1-bit bitmap) for light modules.
+static GBitmap *prv_render_qr(uint8_t *qrcode, GSize size) {
+	int modules_per_side = qrcodegen_getSize(qrcode);
+	int ppm = (size.w < size.h ? size.w : size.h) / modules_per_side;
+	int side = ppm * modules_per_side;
+	GBitmap *bitmap = gbitmap_create_blank(GSize(side, side), GBitmapFormat1Bit);
+	if (bitmap == NULL) {
+		return NULL;
+	}
+	uint8_t *pixels = gbitmap_get_data(bitmap);
+	int stride = gbitmap_get_bytes_per_row(bitmap);
+	memset(pixels, 0, stride * side);
+	for (int y = 0; y < side; ++y) {
+		uint8_t *row = pixels + y * stride;
+		for (int x = 0; x < side; ++x) {
+			if (!qrcodegen_getModule(qrcode, x / ppm, y / ppm)) {
+				row[x >> 3] |= 1 << (x & 7);
+			}
+		}
+	}
+	return bitmap;
 }
 
-static void prv_silly_short_encoding(uint16_t word, char* buffer) {
-	const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
-	if (word > 36 * 36) {
-		APP_LOG(APP_LOG_LEVEL_ERROR, "%d is larger than 1296, the largest number we can encode.", word);
-		buffer[0] = '9';
-		buffer[1] = '9';
+#else
+// Only the part of the code that's on screen is touched, as the layer scrolls.
+static void prv_stream_qr(Layer *layer, GContext *ctx, uint8_t *qrcode) {
+	GRect bounds = layer_get_bounds(layer);
+	int modules_per_side = qrcodegen_getSize(qrcode);
+	int ppm = (bounds.size.w < bounds.size.h ? bounds.size.w : bounds.size.h) / modules_per_side;
+	int side = ppm * modules_per_side;
+	GRect rect = layer_convert_rect_to_screen(layer, GRect((bounds.size.w - side) / 2, (bounds.size.h - side) / 2, side, side));
+	GBitmap *fb_bitmap = graphics_capture_frame_buffer(ctx);
+	if (fb_bitmap == NULL) {
 		return;
 	}
-	buffer[0] = alphabet[word / 36];
-	buffer[1] = alphabet[word % 36];
+	GRect visible = rect;
+	GRect screen = gbitmap_get_bounds(fb_bitmap);
+	grect_clip(&visible, &screen);
+	if (visible.size.w > 0 && visible.size.h > 0) {
+		uint8_t *data = gbitmap_get_data(fb_bitmap);
+		int stride = gbitmap_get_bytes_per_row(fb_bitmap);
+		bool one_bit = gbitmap_get_format(fb_bitmap) == GBitmapFormat1Bit;
+		int x0 = visible.origin.x;
+		int x1 = visible.origin.x + visible.size.w;
+		for (int y = visible.origin.y; y < visible.origin.y + visible.size.h; ++y) {
+			uint8_t *row = data + y * stride;
+			if (y == visible.origin.y || (y - rect.origin.y) % ppm == 0) {
+				prv_draw_row(row, one_bit, x0, x1, rect.origin.x, ppm, qrcode, (y - rect.origin.y) / ppm);
+			} else {
+				prv_copy_row(row, row - stride, one_bit, x0, x1);
+			}
+		}
+	}
+	graphics_release_frame_buffer(ctx, fb_bitmap);
 }
 
-static void prv_update_proc(Layer *layer, GContext *ctx) {
-	ShareLayerData *data = layer_get_data(layer);
-	if (!data->has_qr_code) {
-		graphics_context_set_fill_color(ctx, GColorRed);
-		graphics_fill_rect(ctx, layer_get_bounds(layer), 0, GCornerNone);
-		return;
+// Light modules are white; in a 1-bit frame buffer that's a set bit, and the leftmost pixel
+// of each byte is in its lowest bit.
+static void prv_draw_row(uint8_t *row, bool one_bit, int x0, int x1, int left, int ppm, uint8_t *qrcode, int module_y) {
+	for (int x = x0; x < x1; ++x) {
+		bool light = !qrcodegen_getModule(qrcode, (x - left) / ppm, module_y);
+		if (!one_bit) {
+			row[x] = light ? GColorWhite.argb : GColorBlack.argb;
+		} else if (light) {
+			row[x >> 3] |= 1 << (x & 7);
+		} else {
+			row[x >> 3] &= ~(1 << (x & 7));
+		}
 	}
+}
 
-	int modules_per_side = qrcodegen_getSize(data->qrcode);
-	GRect bounds = layer_get_bounds(layer);
-	int ppm = (bounds.size.w < bounds.size.h ? bounds.size.w : bounds.size.h) / modules_per_side;
-	int offset_x = (bounds.size.w - ppm * modules_per_side) / 2;
-	int offset_y = (bounds.size.h - ppm * modules_per_side) / 2;
-	for (int i = 0; i < modules_per_side; ++i) {
-		for (int j = 0; j < modules_per_side; ++j) {
-			GColor color = qrcodegen_getModule(data->qrcode, i, j) ? GColorBlack : GColorWhite;
-			graphics_context_set_fill_color(ctx, color);
-			graphics_fill_rect(ctx, GRect(offset_x + i * ppm, offset_y + j * ppm, ppm, ppm), 0, GCornerNone);
-		}
+static void prv_copy_row(uint8_t *row, uint8_t *source, bool one_bit, int x0, int x1) {
+	if (!one_bit) {
+		memcpy(row + x0, source + x0, x1 - x0);
+		return;
+	}
+	int first = x0 >> 3;
+	int last = (x1 - 1) >> 3;
+	uint8_t head = 0xFF << (x0 & 7);
+	uint8_t tail = 0xFF >> (7 - ((x1 - 1) & 7));
+	if (first == last) {
+		head &= tail;
+	}
+	row[first] = (row[first] & ~head) | (source[first] & head);
+	if (first == last) {
+		return;
 	}
+	memcpy(row + first + 1, source + first + 1, last - first - 1);
+	row[last] = (row[last] & ~tail) | (source[last] & tail);
 }
+#endif
@@ -1,9 +1,7 @@
 #include <pebble.h>
-#include "model.h"
-#include "game.h"
 
 typedef Layer ShareLayer;
 
 ShareLayer *share_layer_create(GRect frame);
 void share_layer_destroy(ShareLayer *layer);
-void share_layer_set_game_state(ShareLayer *layer, int wordle_num, LetterStatus guesses[GUESS_LIMIT][WORD_LENGTH]);
+void share_layer_set_qr_code(ShareLayer *layer, uint8_t *qrcode);
@@ -0,0 +1,88 @@
+#include <pebble.h>
+#include "span_fill.h"
+
+// Fills a row at a time. The pattern for a row is the same byte (1-bit) or alternating
+// bytes (8-bit) all the way along, so the middle of each row is done with masked 32-bit
+// stores and only the unaligned ends go a byte at a time.
+
+#define REPEAT_BYTE(b) ((uint32_t)(b) * 0x01010101u)
+
+static void prv_fill_row_8bit(uint8_t *row, int x0, int x1, int odd, uint8_t value);
+static void prv_fill_row_1bit(uint8_t *row, int x0, int x1, int odd, uint8_t value);
+static void prv_blend(uint8_t *byte, uint8_t mask, uint8_t value);
+static void prv_blend_words(uint8_t *bytes, int count, uint32_t mask, uint32_t value);
+
+void span_fill_checkerboard(GBitmap *frame_buffer, GRect rect, GColor color) {
+	GRect screen = gbitmap_get_bounds(frame_buffer);
+	grect_clip(&rect, &screen);
+	if (rect.size.w <= 0 || rect.size.h <= 0) {
+		return;
+	}
+	uint8_t *data = gbitmap_get_data(frame_buffer);
+	int stride = gbitmap_get_bytes_per_row(frame_buffer);
+	int x1 = rect.origin.x + rect.size.w;
+	bool one_bit = gbitmap_get_format(frame_buffer) == GBitmapFormat1Bit;
+	uint8_t value = one_bit ? (gcolor_equal(color, GColorBlack) ? 0x00 : 0xFF) : color.argb;
+	for (int y = rect.origin.y; y < rect.origin.y + rect.size.h; ++y) {
+		if (one_bit) {
+			prv_fill_row_1bit(data + y * stride, rect.origin.x, x1, y & 1, value);
+		} else {
+			prv_fill_row_8bit(data + y * stride, rect.origin.x, x1, y & 1, value);
+		}
+	}
+}
+
+// One byte per pixel; the filled pixels are every other byte.
+static void prv_fill_row_8bit(uint8_t *row, int x0, int x1, int odd, uint8_t value) {
+	int x = x0;
+	for (; x < x1 && ((uintptr_t)(row + x) & 3) != 0; ++x) {
+		if (((x ^ odd) & 1) == 0) {
+			row[x] = value;
+		}
+	}
+	// Little-endian, so the lowest byte of each word is pixel x.
+	uint32_t mask = ((x ^ odd) & 1) == 0 ? 0x00FF00FF : 0xFF00FF00;
+	int words = (x1 - x) / 4;
+	prv_blend_words(row + x, words, mask, REPEAT_BYTE(value));
+	for (x += words * 4; x < x1; ++x) {
+		if (((x ^ odd) & 1) == 0) {
+			row[x] = value;
+		}
+	}
+}
+
+// One bit per pixel, with the leftmost pixel of each byte in its lowest bit.
+static void prv_fill_row_1bit(uint8_t *row, int x0, int x1, int odd, uint8_t value) {
+	uint8_t pattern = odd ? 0xAA : 0x55;
+	int first = x0 >> 3;
+	int last = (x1 - 1) >> 3;
+	uint8_t head = 0xFF << (x0 & 7);
+	uint8_t tail = 0xFF >> (7 - ((x1 - 1) & 7));
+	if (first == last) {
+		prv_blend(row + first, pattern & head & tail, value);
+		return;
+	}
+	prv_blend(row + first, pattern & head, value);
+	int i = first + 1;
+	for (; i < last && ((uintptr_t)(row + i) & 3) != 0; ++i) {
+		prv_blend(row + i, pattern, value);
+	}
+	int words = (last - i) / 4;
+	prv_blend_words(row + i, words, REPEAT_BYTE(pattern), REPEAT_BYTE(value));
+	for (i += words * 4; i < last; ++i) {
+		prv_blend(row + i, pattern, value);
+	}
+	prv_blend(row + last, pattern & tail, value);
+}
+
+static void prv_blend(uint8_t *byte, uint8_t mask, uint8_t value) {
+	*byte = (*byte & ~mask) | (value & mask);
+}
+
+static void prv_blend_words(uint8_t *bytes, int count, uint32_t mask, uint32_t value) {
+	uint32_t *words = (uint32_t *)bytes;
+	value &= mask;
+	for (int i = 0; i < count; ++i) {
+		words[i] = (words[i] & ~mask) | value;
+	}
+}
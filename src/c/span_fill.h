@@ -0,0 +1,12 @@
+#ifndef SPAN_FILL_H
+#define SPAN_FILL_H
+
+#include <pebble.h>
+
+// Fills rect, in screen coordinates, with a checkerboard of color over whatever is already in
+// the frame buffer. The pattern is anchored to the screen rather than to rect: pixel (x, y) is
+// filled when x + y is even, so neighbouring fills line up. Works on both the 8-bit frame
+// buffer and the 1-bit one, and rect is clipped to the screen.
+void span_fill_checkerboard(GBitmap *frame_buffer, GRect rect, GColor color);
+
+#endif
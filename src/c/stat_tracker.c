@@ -2,67 +2,172 @@
 #include "stat_tracker.h"
 #include "model.h"
 
+// Besides the running totals, every day's result is kept in a ring of 3-bit entries indexed
+// by wordle number: 0 for not played, 1-6 for a win in that many guesses, 7 for a loss. The
+// ring is split across several persist keys, since each holds at most 256 bytes, and is only
+// read in when a result is recorded or looked up. The totals are updated as each result comes
+// in, and the history is only walked when a result arrives out of order and could join or
+// break a streak.
+
 #define STAT_TRACKER_VERSION_KEY 3
 #define STAT_TRACKER_CONTENT_KEY 4
+#define STAT_TRACKER_HISTORY_KEY 5
+#define STAT_TRACKER_VERSION 2
 
-struct StatTracker {
+#define HISTORY_CHUNKS 3
+#define HISTORY_CHUNK_SIZE PERSIST_DATA_MAX_LENGTH
+#define HISTORY_SIZE (HISTORY_CHUNKS * HISTORY_CHUNK_SIZE)
+#define HISTORY_DAYS (HISTORY_SIZE * 8 / 3)
+
+#define RESULT_NOT_PLAYED 0
+#define RESULT_LOST 7
+
+// Version 1 had only the totals, with last_wordle being the last day won.
+typedef struct {
 	short current_streak;
 	short max_streak;
 	short last_wordle;
 	short distribution[7];
-} __attribute__((packed));
+} __attribute__((packed)) StatTrackerV1;
+
+typedef struct {
+	short current_streak;
+	short max_streak;
+	// The newest day with a result.
+	short last_wordle;
+	short distribution[7];
+	// The first day the history covers, and the streak that was running the day before it, for
+	// totals carried over from version 1.
+	short history_start;
+	short carried_streak;
+} __attribute__((packed)) StatTotals;
+
+struct StatTracker {
+	StatTotals totals;
+	uint8_t *history;
+	uint8_t dirty_chunks;
+};
+
+static bool prv_load_history(StatTracker *tracker);
+static void prv_save(StatTracker *tracker);
+static int prv_get(StatTracker *tracker, int wordle_num);
+static void prv_set(StatTracker *tracker, int wordle_num, int value);
+static bool prv_won(StatTracker *tracker, int wordle_num);
+static int prv_wins_before(StatTracker *tracker, int wordle_num);
+static int prv_wins_after(StatTracker *tracker, int wordle_num);
 
 StatTracker *stat_tracker_load() {
 	StatTracker *tracker = malloc(sizeof(StatTracker));
-	if (persist_read_int(STAT_TRACKER_VERSION_KEY) == 1) {
-		persist_read_data(STAT_TRACKER_CONTENT_KEY, tracker, sizeof(StatTracker));
-	} else {
-		memset(tracker, 0, sizeof(StatTracker));
+	memset(tracker, 0, sizeof(StatTracker));
+	switch (persist_read_int(STAT_TRACKER_VERSION_KEY)) {
+		case 1: {
+			StatTrackerV1 old;
+			persist_read_data(STAT_TRACKER_CONTENT_KEY, &old, sizeof(old));
+			tracker->totals.current_streak = old.current_streak;
+			tracker->totals.max_streak = old.max_streak;
+			tracker->totals.last_wordle = old.last_wordle;
+			memcpy(tracker->totals.distribution, old.distribution, sizeof(old.distribution));
+			tracker->totals.history_start = old.last_wordle + 1;
+			tracker->totals.carried_streak = old.current_streak;
+			break;
+		}
+		case STAT_TRACKER_VERSION:
+			persist_read_data(STAT_TRACKER_CONTENT_KEY, &tracker->totals, sizeof(StatTotals));
+			break;
 	}
 	return tracker;
 }
 
 void stat_tracker_destroy(StatTracker *stat_tracker) {
+	if (stat_tracker == NULL) {
+		return;
+	}
+	free(stat_tracker->history);
 	free(stat_tracker);
 }
 
 void stat_tracker_record_result(StatTracker *stat_tracker, int wordle_num, int result) {
-	if (result > 0) {
-		if (stat_tracker->last_wordle >= wordle_num - 1) {
-			stat_tracker->current_streak++;
+	StatTotals *totals = &stat_tracker->totals;
+	if (!prv_load_history(stat_tracker)) {
+		return;
+	}
+	// A day only has one result; the game may try to record it again if it's reopened.
+	// Days the history doesn't cover can't be checked, so they aren't recorded either.
+	if (prv_get(stat_tracker, wordle_num) != RESULT_NOT_PLAYED || wordle_num < totals->history_start ||
+			wordle_num <= totals->last_wordle - HISTORY_DAYS) {
+		return;
+	}
+	// Days skipped since the newest result still hold whatever the ring had a lap ago.
+	if (wordle_num > totals->last_wordle) {
+		int first = totals->last_wordle + 1;
+		if (first < wordle_num - HISTORY_DAYS) {
+			first = wordle_num - HISTORY_DAYS;
+		}
+		for (int day = first; day < wordle_num; ++day) {
+			prv_set(stat_tracker, day, RESULT_NOT_PLAYED);
+		}
+	}
+	prv_set(stat_tracker, wordle_num, result > 0 ? result : RESULT_LOST);
+	totals->distribution[result]++;
+
+	if (wordle_num > totals->last_wordle) {
+		if (result > 0) {
+			totals->current_streak = wordle_num == totals->last_wordle + 1 ? totals->current_streak + 1 : 1;
 		} else {
-			stat_tracker->current_streak = 1;
+			totals->current_streak = 0;
 		}
-		if (stat_tracker->current_streak > stat_tracker->max_streak) {
-			stat_tracker->max_streak = stat_tracker->current_streak;
+		totals->last_wordle = wordle_num;
+	} else if (result > 0) {
+		// A late result for an earlier day, after a missed sync or a timezone change. It can
+		// only join the streaks either side of it, and that matters for the current streak if
+		// it reaches the newest day.
+		int after = prv_wins_after(stat_tracker, wordle_num);
+		if (wordle_num + after == totals->last_wordle) {
+			totals->current_streak = after + 1 + prv_wins_before(stat_tracker, wordle_num);
 		}
-		stat_tracker->last_wordle = wordle_num;
-	} else {
-		stat_tracker->current_streak = 0;
 	}
-	stat_tracker->distribution[result]++;
-	persist_write_int(STAT_TRACKER_VERSION_KEY, 1);
-	persist_write_data(STAT_TRACKER_CONTENT_KEY, stat_tracker, sizeof(StatTracker));
+	if (result > 0) {
+		int streak = prv_wins_before(stat_tracker, wordle_num) + 1 + prv_wins_after(stat_tracker, wordle_num);
+		if (streak > totals->max_streak) {
+			totals->max_streak = streak;
+		}
+	}
+	prv_save(stat_tracker);
+}
+
+int stat_tracker_get_result(StatTracker *tracker, int wordle_num) {
+	if (!prv_load_history(tracker)) {
+		return -1;
+	}
+	int result = prv_get(tracker, wordle_num);
+	switch (result) {
+		case RESULT_NOT_PLAYED:
+			return -1;
+		case RESULT_LOST:
+			return 0;
+		default:
+			return result;
+	}
 }
 
 int stat_tracker_get_current_streak(StatTracker *tracker) {
-	return tracker->last_wordle >= wordle_number() - 1 ? tracker->current_streak : 0;
+	return tracker->totals.last_wordle >= wordle_number() - 1 ? tracker->totals.current_streak : 0;
 }
 
 int stat_tracker_get_max_streak(StatTracker *tracker) {
-	return tracker->max_streak;
+	return tracker->totals.max_streak;
 }
 
 int stat_tracker_get_total_played(StatTracker *tracker) {
 	int total = 0;
 	for (int i = 0; i < 7; ++i) {
-		total += tracker->distribution[i];
+		total += tracker->totals.distribution[i];
 	}
 	return total;
 }
 
 int stat_tracker_get_win_percent(StatTracker *tracker) {
-	int percent = tracker->distribution[0] * 100;
+	int percent = tracker->totals.distribution[0] * 100;
 	int total_played = stat_tracker_get_total_played(tracker);
 	if (total_played == 0) {
 		return 100;
@@ -73,5 +178,91 @@ int stat_tracker_get_win_percent(StatTracker *tracker) {
 }
 
 int stat_tracker_get_distribution_bucket(StatTracker *tracker, int bucket) {
-	return tracker->distribution[bucket];
+	return tracker->totals.distribution[bucket];
+}
+
+static bool prv_load_history(StatTracker *tracker) {
+	if (tracker->history != NULL) {
+		return true;
+	}
+	tracker->history = malloc(HISTORY_SIZE);
+	if (tracker->history == NULL) {
+		return false;
+	}
+	memset(tracker->history, 0, HISTORY_SIZE);
+	if (persist_read_int(STAT_TRACKER_VERSION_KEY) == STAT_TRACKER_VERSION) {
+		for (int i = 0; i < HISTORY_CHUNKS; ++i) {
+			persist_read_data(STAT_TRACKER_HISTORY_KEY + i, tracker->history + i * HISTORY_CHUNK_SIZE, HISTORY_CHUNK_SIZE);
+		}
+	} else {
+		// Nothing of the history is in flash yet.
+		tracker->dirty_chunks = (1 << HISTORY_CHUNKS) - 1;
+	}
+	return true;
+}
+
+static void prv_save(StatTracker *tracker) {
+	for (int i = 0; i < HISTORY_CHUNKS; ++i) {
+		if (tracker->dirty_chunks & (1 << i)) {
+			persist_write_data(STAT_TRACKER_HISTORY_KEY + i, tracker->history + i * HISTORY_CHUNK_SIZE, HISTORY_CHUNK_SIZE);
+		}
+	}
+	tracker->dirty_chunks = 0;
+	persist_write_data(STAT_TRACKER_CONTENT_KEY, &tracker->totals, sizeof(StatTotals));
+	persist_write_int(STAT_TRACKER_VERSION_KEY, STAT_TRACKER_VERSION);
+}
+
+// Days before the history starts, and days the ring has since lapped, read as not played.
+static int prv_get(StatTracker *tracker, int wordle_num) {
+	StatTotals *totals = &tracker->totals;
+	if (wordle_num < 0 || wordle_num < totals->history_start || wordle_num > totals->last_wordle ||
+			wordle_num <= totals->last_wordle - HISTORY_DAYS) {
+		return RESULT_NOT_PLAYED;
+	}
+	int bit = wordle_num % HISTORY_DAYS * 3;
+	int value = 0;
+	for (int i = 0; i < 3; ++i, ++bit) {
+		value |= ((tracker->history[bit >> 3] >> (bit & 7)) & 1) << i;
+	}
+	return value;
+}
+
+static void prv_set(StatTracker *tracker, int wordle_num, int value) {
+	int bit = wordle_num % HISTORY_DAYS * 3;
+	for (int i = 0; i < 3; ++i, ++bit) {
+		uint8_t mask = 1 << (bit & 7);
+		if (value & (1 << i)) {
+			tracker->history[bit >> 3] |= mask;
+		} else {
+			tracker->history[bit >> 3] &= ~mask;
+		}
+		tracker->dirty_chunks |= 1 << ((bit >> 3) / HISTORY_CHUNK_SIZE);
+	}
+}
+
+static bool prv_won(StatTracker *tracker, int wordle_num) {
+	int result = prv_get(tracker, wordle_num);
+	return result != RESULT_NOT_PLAYED && result != RESULT_LOST;
+}
+
+// The number of days won in a row up to the day before wordle_num, including any streak
+// carried over from before the history started.
+static int prv_wins_before(StatTracker *tracker, int wordle_num) {
+	int day = wordle_num - 1;
+	while (prv_won(tracker, day)) {
+		--day;
+	}
+	int wins = wordle_num - 1 - day;
+	if (day == tracker->totals.history_start - 1) {
+		wins += tracker->totals.carried_streak;
+	}
+	return wins;
+}
+
+static int prv_wins_after(StatTracker *tracker, int wordle_num) {
+	int day = wordle_num + 1;
+	while (prv_won(tracker, day)) {
+		++day;
+	}
+	return day - wordle_num - 1;
 }
@@ -12,5 +12,7 @@ int stat_tracker_get_max_streak(StatTracker *tracker);
 int stat_tracker_get_total_played(StatTracker *tracker);
 int stat_tracker_get_win_percent(StatTracker *tracker);
 int stat_tracker_get_distribution_bucket(StatTracker *tracker, int bucket);
+// The number of guesses it took to win that day, 0 for a loss, or -1 if it wasn't played.
+int stat_tracker_get_result(StatTracker *tracker, int wordle_num);
 
 #endif
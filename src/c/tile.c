@@ -0,0 +1,161 @@
+#include <pebble.h>
+#include "tile.h"
+#include "span_fill.h"
+
+static GColor s_layer_colors[LetterStatusCount] = {
+	GColorWhite,
+	PBL_IF_COLOR_ELSE(GColorLightGray, GColorDarkGray),
+	PBL_IF_COLOR_ELSE(GColorYellow, GColorWhite),
+	PBL_IF_COLOR_ELSE(GColorGreen, GColorBlack),
+};
+
+static GColor s_text_colors[LetterStatusCount] = {
+	GColorBlack,
+	GColorBlack,
+	GColorBlack,
+	PBL_IF_COLOR_ELSE(GColorBlack, GColorWhite),
+};
+
+// One TILE_SIZE square cell per letter, top to bottom, with the glyph's pixels set.
+static GBitmap *s_glyphs;
+
+static char prv_to_upper(char lower);
+static void prv_draw_letter(GContext *ctx, GRect rect, char letter, GColor color);
+static GRect prv_text_rect(GRect rect);
+static void prv_copy_glyph(GBitmap *frame_buffer, GPoint origin, int index);
+
+bool tile_has_checkerboard(bool confirmed) {
+	return PBL_IF_COLOR_ELSE(!confirmed, false);
+}
+
+void tile_draw_checkerboard(GBitmap *frame_buffer, GRect screen_rect, LetterStatus status) {
+	span_fill_checkerboard(frame_buffer, screen_rect, s_layer_colors[status]);
+}
+
+void tile_draw(GContext *ctx, GRect rect, char letter, LetterStatus status, bool confirmed) {
+	GRect inner = GRect(rect.origin.x + 1, rect.origin.y + 1, rect.size.w - 2, rect.size.h - 2);
+	graphics_context_set_stroke_color(ctx, GColorBlack);
+	if (confirmed) {
+		graphics_context_set_fill_color(ctx, s_layer_colors[status]);
+		#ifdef PBL_COLOR
+		graphics_fill_rect(ctx, inner, 0, GCornerNone);
+		#else
+		if (status == LetterStatusWrongPosition) {
+			graphics_draw_rect(ctx, inner);
+		} else {
+			graphics_fill_rect(ctx, inner, 0, GCornerNone);
+		}
+		#endif
+	}
+	graphics_draw_rect(ctx, rect);
+
+	if (letter != 0) {
+		prv_draw_letter(ctx, rect, letter, PBL_IF_COLOR_ELSE(true, confirmed) ? s_text_colors[status] : GColorBlack);
+	}
+}
+
+bool tile_prepare_glyphs(Layer *layer, GContext *ctx) {
+	if (s_glyphs != NULL) {
+		return true;
+	}
+	GRect bounds = layer_get_bounds(layer);
+	int columns = bounds.size.w / TILE_SIZE;
+	if (columns == 0 || columns * (bounds.size.h / TILE_SIZE) < 26) {
+		return false;
+	}
+	GRect screen_rect = layer_convert_rect_to_screen(layer, bounds);
+	GRect screen = GRect(0, 0, 0, 0);
+	s_glyphs = gbitmap_create_blank(GSize(TILE_SIZE, TILE_SIZE * 26), GBitmapFormat1Bit);
+	if (s_glyphs == NULL) {
+		return false;
+	}
+	memset(gbitmap_get_data(s_glyphs), 0, gbitmap_get_bytes_per_row(s_glyphs) * TILE_SIZE * 26);
+
+	graphics_context_set_fill_color(ctx, GColorWhite);
+	graphics_fill_rect(ctx, bounds, 0, GCornerNone);
+	graphics_context_set_text_color(ctx, GColorBlack);
+	for (int i = 0; i < 26; ++i) {
+		char letter_string[2] = {'A' + i, 0};
+		GRect cell = GRect(bounds.origin.x + i % columns * TILE_SIZE, bounds.origin.y + i / columns * TILE_SIZE, TILE_SIZE, TILE_SIZE);
+		graphics_draw_text(ctx, letter_string, fonts_get_system_font(FONT_KEY_GOTHIC_18_BOLD), prv_text_rect(cell), GTextOverflowModeWordWrap, GTextAlignmentCenter, NULL);
+	}
+
+	GBitmap *fb_bitmap = graphics_capture_frame_buffer(ctx);
+	if (fb_bitmap != NULL) {
+		screen = gbitmap_get_bounds(fb_bitmap);
+	}
+	if (fb_bitmap == NULL || !grect_contains_point(&screen, &screen_rect.origin) ||
+			screen_rect.origin.x + screen_rect.size.w > screen.size.w || screen_rect.origin.y + screen_rect.size.h > screen.size.h) {
+		gbitmap_destroy(s_glyphs);
+		s_glyphs = NULL;
+	} else {
+		for (int i = 0; i < 26; ++i) {
+			prv_copy_glyph(fb_bitmap, GPoint(screen_rect.origin.x + i % columns * TILE_SIZE, screen_rect.origin.y + i / columns * TILE_SIZE), i);
+		}
+	}
+	if (fb_bitmap != NULL) {
+		graphics_release_frame_buffer(ctx, fb_bitmap);
+	}
+	graphics_fill_rect(ctx, bounds, 0, GCornerNone);
+	return s_glyphs != NULL;
+}
+
+bool tile_glyphs_ready() {
+	return s_glyphs != NULL;
+}
+
+void tile_deinit() {
+	if (s_glyphs != NULL) {
+		gbitmap_destroy(s_glyphs);
+		s_glyphs = NULL;
+	}
+}
+
+// The glyph is a 1-bit mask with the letter's pixels set, so it's drawn in black by clearing
+// through it and in white by OR-ing it in. (GCompOpSet would paint the cell around the letter
+// instead, since it paints where the source is black.) While a tile is flipping, only the
+// middle rows of its cell are shown, just as the text would be clipped by a shrinking layer.
+static void prv_draw_letter(GContext *ctx, GRect rect, char letter, GColor color) {
+	int top = (TILE_SIZE - rect.size.h) / 2;
+	if (s_glyphs == NULL) {
+		// Without the glyphs, nothing clips the text, so it's left out of narrow tiles.
+		if (rect.size.h >= TILE_SIZE / 2) {
+			char letter_string[2] = {prv_to_upper(letter), 0};
+			graphics_context_set_text_color(ctx, color);
+			graphics_draw_text(ctx, letter_string, fonts_get_system_font(FONT_KEY_GOTHIC_18_BOLD), prv_text_rect(rect), GTextOverflowModeWordWrap, GTextAlignmentCenter, NULL);
+		}
+		return;
+	}
+	gbitmap_set_bounds(s_glyphs, GRect(0, (letter - 'a') * TILE_SIZE + top, TILE_SIZE, rect.size.h));
+	graphics_context_set_compositing_mode(ctx, gcolor_equal(color, GColorWhite) ? GCompOpOr : GCompOpClear);
+	graphics_draw_bitmap_in_rect(ctx, s_glyphs, rect);
+	graphics_context_set_compositing_mode(ctx, GCompOpAssign);
+}
+
+static GRect prv_text_rect(GRect rect) {
+	return GRect(rect.origin.x, rect.origin.y - (TILE_SIZE - rect.size.h)/2 - 1, rect.size.w, rect.size.h);
+}
+
+// Anything that isn't white in the cell at origin is part of the glyph.
+static void prv_copy_glyph(GBitmap *frame_buffer, GPoint origin, int index) {
+	uint8_t *src = gbitmap_get_data(frame_buffer);
+	int src_stride = gbitmap_get_bytes_per_row(frame_buffer);
+	bool one_bit = gbitmap_get_format(frame_buffer) == GBitmapFormat1Bit;
+	uint8_t *dest = gbitmap_get_data(s_glyphs);
+	int dest_stride = gbitmap_get_bytes_per_row(s_glyphs);
+	for (int y = 0; y < TILE_SIZE; ++y) {
+		uint8_t *src_row = src + (origin.y + y) * src_stride;
+		uint8_t *dest_row = dest + (index * TILE_SIZE + y) * dest_stride;
+		for (int x = 0; x < TILE_SIZE; ++x) {
+			int sx = origin.x + x;
+			bool set = one_bit ? !(src_row[sx >> 3] & (1 << (sx & 7))) : src_row[sx] != GColorWhite.argb;
+			if (set) {
+				dest_row[x >> 3] |= 1 << (x & 7);
+			}
+		}
+	}
+}
+
+static char prv_to_upper(char lower) {
+	return lower - ('a' - 'A');
+}
@@ -0,0 +1,25 @@
+#ifndef TILE_H
+#define TILE_H
+
+#include <pebble.h>
+#include "model.h"
+
+#define TILE_SIZE 23
+
+// Unconfirmed tiles on color platforms are shaded with a checkerboard of the letter's status
+// color, which goes straight into the frame buffer, so it's drawn apart from the rest of the
+// tile. screen_rect is in screen coordinates.
+bool tile_has_checkerboard(bool confirmed);
+void tile_draw_checkerboard(GBitmap *frame_buffer, GRect screen_rect, LetterStatus status);
+// Draws the tile's fill once it's confirmed, its border and its letter, if it has one.
+void tile_draw(GContext *ctx, GRect rect, char letter, LetterStatus status, bool confirmed);
+
+// Renders A-Z with the system font into the layer's area of the frame buffer and keeps them as
+// a bitmap, so that tiles blit their letters from then on rather than laying out text. The
+// layer must be on screen and fit a grid of 26 tiles; its area is left blank afterwards.
+// Returns whether the glyphs are ready.
+bool tile_prepare_glyphs(Layer *layer, GContext *ctx);
+bool tile_glyphs_ready();
+void tile_deinit();
+
+#endif
@@ -1,29 +1,52 @@
 #include <pebble.h>
 #include "title_layer.h"
-#include "letter_layer.h"
+#include "model.h"
+#include "tile.h"
+#include "flip_animation.h"
+
+#define TITLE_LENGTH 6
+
+typedef struct {
+	LetterStatus status;
+	bool shown;
+	uint8_t height;
+} TitleTile;
 
 typedef struct {
-	LetterLayer *letters[6];
-	LetterStatus statuses[6];
+	TitleTile tiles[TITLE_LENGTH];
+	// The tile being flipped on its own, or -1 while they all flip in turn.
+	int flipping;
+	LetterStatus next_status;
+	FlipAnimation flip;
 	int last_flip;
 	AppTimer *timer;
 } TitleLayerData;
 
 static char *s_wordle = "wordle";
 
+static void prv_update_proc(Layer *layer, GContext *ctx);
+static void prv_flip_update(int tile, int height, bool turned, void *context);
 static void prv_schedule_timer(TitleLayer *layer);
 static void prv_timer_callback(void *context);
 
 TitleLayer *title_layer_create(GPoint where, bool animated) {
-	Layer *layer = layer_create_with_data(GRect(where.x, where.y, 6 * (LETTER_LAYER_SIZE + 1), LETTER_LAYER_SIZE), sizeof(TitleLayerData));
+	Layer *layer = layer_create_with_data(GRect(where.x, where.y, TITLE_LENGTH * (TILE_SIZE + 1), TILE_SIZE), sizeof(TitleLayerData));
 	TitleLayerData *data = layer_get_data(layer);
-
-	for (int i = 0; i < 6; ++i) {
-		data->letters[i] = letter_layer_create(GPoint(i * (LETTER_LAYER_SIZE + 1), 0));
-		layer_add_child(layer, data->letters[i]);
-		letter_layer_set_letter(data->letters[i], 0, LetterStatusNeutral, true, false);
-		letter_layer_set_letter(data->letters[i], s_wordle[i], LetterStatusNeutral, true, i+1);
+	for (int i = 0; i < TITLE_LENGTH; ++i) {
+		data->tiles[i] = (TitleTile) {
+			.status = LetterStatusNeutral,
+			.shown = false,
+			.height = TILE_SIZE,
+		};
 	}
+	data->flip = (FlipAnimation) {0};
+	data->last_flip = 0;
+	data->timer = NULL;
+	layer_set_update_proc(layer, prv_update_proc);
+
+	// The letters turn up one after another.
+	data->flipping = -1;
+	flip_animation_start(&data->flip, TITLE_LENGTH, FLIP_DURATION, prv_flip_update, layer);
 
 	if (animated) {
 		data->timer = app_timer_register(2500, prv_timer_callback, layer);
@@ -34,10 +57,35 @@ TitleLayer *title_layer_create(GPoint where, bool animated) {
 
 void title_layer_destroy(TitleLayer *layer) {
 	TitleLayerData *data = layer_get_data(layer);
-	app_timer_cancel(data->timer);
-	for (int i = 0; i < 6; ++i) {
-		letter_layer_destroy(data->letters[i]);
+	if (data->timer != NULL) {
+		app_timer_cancel(data->timer);
+	}
+	flip_animation_stop(&data->flip);
+	layer_destroy(layer);
+}
+
+static void prv_update_proc(Layer *layer, GContext *ctx) {
+	TitleLayerData *data = layer_get_data(layer);
+	for (int i = 0; i < TITLE_LENGTH; ++i) {
+		TitleTile *tile = &data->tiles[i];
+		GRect rect = GRect(i * (TILE_SIZE + 1), (TILE_SIZE - tile->height) / 2, TILE_SIZE, tile->height);
+		tile_draw(ctx, rect, tile->shown ? s_wordle[i] : 0, tile->status, true);
+	}
+}
+
+static void prv_flip_update(int tile, int height, bool turned, void *context) {
+	TitleLayer *layer = (TitleLayer *)context;
+	TitleLayerData *data = layer_get_data(layer);
+	TitleTile *title_tile = &data->tiles[data->flipping < 0 ? tile : data->flipping];
+	if (turned) {
+		if (data->flipping < 0) {
+			title_tile->shown = true;
+		} else {
+			title_tile->status = data->next_status;
+		}
 	}
+	title_tile->height = height;
+	layer_mark_dirty(layer);
 }
 
 static void prv_schedule_timer(TitleLayer *layer) {
@@ -50,14 +98,17 @@ static void prv_timer_callback(void *context) {
 	TitleLayerData *data = layer_get_data(layer);
 	int i;
 	do {
-		i = rand() % 6;
+		i = rand() % TITLE_LENGTH;
 	} while (i == data->last_flip);
 	data->last_flip = i;
 	LetterStatus status;
 	do {
 		status = rand() % LetterStatusCount;
-	} while (status == data->statuses[i]);
-	data->statuses[i] = status;
-	letter_layer_set_letter(data->letters[i], s_wordle[i], status, true, true);
+	} while (status == data->tiles[i].status);
+	// Finish any flip still going before the next one takes over.
+	flip_animation_stop(&data->flip);
+	data->flipping = i;
+	data->next_status = status;
+	flip_animation_start(&data->flip, 1, 0, prv_flip_update, layer);
 	prv_schedule_timer(layer);
 }
@@ -0,0 +1,66 @@
+"""
+Builds a Bloom filter over the accepted word ranks, used to reject most invalid guesses
+without touching the dictionary resource.
+
+Layout (little-endian):
+
+    uint16 byte_count   0 if the filter is disabled for this platform
+    uint8  hash_count
+    uint8  reserved
+    uint8  bits[byte_count]
+
+Bit positions for a rank are (h1 + i * h2) % (byte_count * 8) for i in [0, hash_count),
+where h1 and h2 are the low and high halves of mix32(rank). This must match
+prv_bloom_may_contain() in src/c/dictionary.c.
+"""
+import math
+import struct
+
+from wordlist import sorted_ranks
+
+HEADER_FORMAT = '<HBB'
+MAX_BYTES = 0xFFFF
+
+
+def mix32(x):
+    x = (x * 0x9E3779B1) & 0xFFFFFFFF
+    x ^= x >> 15
+    x = (x * 0x85EBCA77) & 0xFFFFFFFF
+    x ^= x >> 13
+    return x
+
+
+def size_filter(count, byte_count=None, false_positive_rate=None):
+    """
+    Picks (byte_count, hash_count) from either a memory budget or a target false positive
+    rate, and returns them with the false positive rate that results.
+    """
+    if byte_count is None:
+        if false_positive_rate is None:
+            raise ValueError("a Bloom filter needs either 'bytes' or 'false_positive_rate'")
+        bits = -count * math.log(false_positive_rate) / (math.log(2) ** 2)
+        byte_count = int(math.ceil(bits / 8))
+    byte_count = min(byte_count, MAX_BYTES)
+    bits = byte_count * 8
+    hash_count = max(1, int(round(bits / float(count) * math.log(2))))
+    rate = (1 - math.exp(-hash_count * count / float(bits))) ** hash_count
+    return byte_count, hash_count, rate
+
+
+def disabled():
+    return struct.pack(HEADER_FORMAT, 0, 0, 0)
+
+
+def encode(words, byte_count=None, false_positive_rate=None):
+    ranks = sorted_ranks(words)
+    byte_count, hash_count, rate = size_filter(len(ranks), byte_count, false_positive_rate)
+    bit_count = byte_count * 8
+    bits = bytearray(byte_count)
+    for rank in ranks:
+        h = mix32(rank)
+        h1 = h & 0xFFFF
+        h2 = (h >> 16) | 1
+        for i in range(hash_count):
+            bit = (h1 + i * h2) % bit_count
+            bits[bit >> 3] |= 1 << (bit & 7)
+    return struct.pack(HEADER_FORMAT, byte_count, hash_count, 0) + bytes(bits), rate
@@ -0,0 +1,111 @@
+"""
+Encodes the acceptable word list as an Elias-Fano sequence of base-26 ranks.
+
+Layout (all integers little-endian, bit streams LSB-first within each byte):
+
+    uint16 word_count
+    uint8  lower_bits         bits of each rank stored verbatim in the lower stream
+    uint8  max_bucket         most ranks sharing a single upper value
+    uint16 upper_bytes        length of the upper bit stream
+    uint16 lower_bytes        length of the lower bit stream
+    uint16 prefix_index[677]  for each two-letter prefix p, the number of ranks whose
+                              upper value is below (p * 26^3) >> lower_bits
+    upper bit stream          unary-coded upper values: rank i sets bit i + (rank >> lower_bits)
+    lower bit stream          word_count * lower_bits bits
+
+The prefix index doubles as the select index for the upper stream: the first element
+whose upper value is at least h_p = (p * 26^3) >> lower_bits starts at bit prefix_index[p] + h_p.
+
+The reader in src/c/dictionary.c loads one prefix's stretch of the upper stream, or one
+upper value's run of the lower stream, into fixed stack buffers, so encode() refuses any
+list where either could outgrow them.
+"""
+import struct
+
+from wordlist import PREFIX_COUNT, PREFIX_SPAN, RANK_LIMIT, sorted_ranks
+
+HEADER_FORMAT = '<HBBHH'
+
+# Must match MAX_UPPER_SPAN_BYTES and MAX_LOWER_SPAN_BYTES in src/c/dictionary.c.
+MAX_UPPER_SPAN_BYTES = 48
+MAX_LOWER_SPAN_BYTES = 48
+
+
+def choose_lower_bits(count, universe):
+    lower_bits = 0
+    while (count << (lower_bits + 1)) <= universe:
+        lower_bits += 1
+    return lower_bits
+
+
+def _pack_bits(bits, length):
+    data = bytearray((length + 7) // 8)
+    for bit in bits:
+        data[bit >> 3] |= 1 << (bit & 7)
+    return bytes(data)
+
+
+def _byte_span(start_bit, end_bit):
+    return (end_bit + 7) // 8 - start_bit // 8
+
+
+def _check_spans(prefix_index, highs, lower_bits, max_bucket, upper_bytes):
+    """Checks the longest reads the C reader makes against its buffers."""
+    longest_upper = 0
+    for p in range(PREFIX_COUNT):
+        start = prefix_index[p] + ((p * PREFIX_SPAN) >> lower_bits)
+        last_high = ((p + 1) * PREFIX_SPAN - 1) >> lower_bits
+        end = min(prefix_index[p + 1] + last_high + max_bucket + 1, upper_bytes * 8)
+        longest_upper = max(longest_upper, _byte_span(start, end))
+
+    longest_lower = 0
+    first = 0
+    for i in range(1, len(highs) + 1):
+        if i == len(highs) or highs[i] != highs[first]:
+            longest_lower = max(longest_lower, _byte_span(first * lower_bits, i * lower_bits))
+            first = i
+
+    if longest_upper > MAX_UPPER_SPAN_BYTES or longest_lower > MAX_LOWER_SPAN_BYTES:
+        raise ValueError("longest upper span is {} bytes and longest lower span {} bytes, but the reader "
+                         "only has room for {} and {}".format(longest_upper, longest_lower,
+                                                              MAX_UPPER_SPAN_BYTES, MAX_LOWER_SPAN_BYTES))
+
+
+def encode(words):
+    ranks = sorted_ranks(words)
+    count = len(ranks)
+    lower_bits = choose_lower_bits(count, RANK_LIMIT)
+    lower_mask = (1 << lower_bits) - 1
+
+    highs = [r >> lower_bits for r in ranks]
+    upper_length = count + ((RANK_LIMIT - 1) >> lower_bits) + 1
+    upper = _pack_bits((i + h for i, h in enumerate(highs)), upper_length)
+
+    lower = bytearray((count * lower_bits + 7) // 8)
+    for i, r in enumerate(ranks):
+        value = r & lower_mask
+        offset = i * lower_bits
+        for b in range(lower_bits):
+            if value & (1 << b):
+                lower[(offset + b) >> 3] |= 1 << ((offset + b) & 7)
+
+    prefix_index = []
+    below = 0
+    for p in range(PREFIX_COUNT + 1):
+        h = (p * PREFIX_SPAN) >> lower_bits
+        while below < count and highs[below] < h:
+            below += 1
+        prefix_index.append(below)
+
+    buckets = {}
+    for h in highs:
+        buckets[h] = buckets.get(h, 0) + 1
+    max_bucket = max(buckets.values())
+
+    if len(upper) > 0xFFFF or len(lower) > 0xFFFF or count > 0xFFFF:
+        raise ValueError("word list too large for the Elias-Fano resource format")
+    _check_spans(prefix_index, highs, lower_bits, max_bucket, len(upper))
+
+    header = struct.pack(HEADER_FORMAT, count, lower_bits, max_bucket, len(upper), len(lower))
+    index = struct.pack('<{}H'.format(len(prefix_index)), *prefix_index)
+    return header + index + upper + bytes(lower)
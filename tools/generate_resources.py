@@ -0,0 +1,105 @@
+"""
+Generates the derived resources under resources/generated/ from the raw word lists.
+
+This is run automatically by the wscript before the app is built, and can also be run
+by hand: python3 tools/generate_resources.py [resources_dir]
+"""
+import os
+import sys
+
+import bloom
+import elias_fano
+import perfect_hash
+import prefix_counts
+import solution_index
+from wordlist import read_words
+
+
+def _write_if_changed(path, data):
+    try:
+        with open(path, 'rb') as f:
+            if f.read() == data:
+                return False
+    except IOError:
+        pass
+    with open(path, 'wb') as f:
+        f.write(data)
+    return True
+
+
+def _is_up_to_date(path, sources):
+    try:
+        built = os.path.getmtime(path)
+    except OSError:
+        return False
+    return all(os.path.getmtime(source) <= built for source in sources)
+
+
+def _read(path):
+    with open(path, 'rb') as f:
+        return f.read()
+
+
+def generate(resources_dir, bloom_filter=None, dictionary_backend=None, solution_index_enabled=None):
+    """
+    bloom_filter maps platform names to Bloom filter settings ({'bytes': n} or
+    {'false_positive_rate': p}), or None to leave the filter out on that platform.
+    dictionary_backend maps platform names to 'elias_fano' or 'perfect_hash'; the perfect
+    hash resource is left empty on platforms that don't use it.
+    solution_index_enabled maps platform names to whether they ship the solution bitsets; those
+    that don't get a header-only resource and rescore the solution list instead.
+    """
+    out_dir = os.path.join(resources_dir, 'generated')
+    if not os.path.isdir(out_dir):
+        os.makedirs(out_dir)
+
+    acceptable_path = os.path.join(resources_dir, 'acceptable.dat')
+    acceptable = read_words(acceptable_path)
+
+    solutions = read_words(os.path.join(resources_dir, 'solutions.dat'))
+
+    outputs = {
+        'acceptable_ef.dat': elias_fano.encode(acceptable),
+        'prefix_counts.dat': prefix_counts.encode(acceptable),
+        'solution_index.dat': solution_index.encode(solutions),
+        # Fallback for any platform not configured below.
+        'bloom.dat': bloom.disabled(),
+    }
+    for platform, settings in sorted((bloom_filter or {}).items()):
+        if settings is None:
+            outputs['bloom~{}.dat'.format(platform)] = bloom.disabled()
+            continue
+        data, rate = bloom.encode(acceptable, byte_count=settings.get('bytes'),
+                                  false_positive_rate=settings.get('false_positive_rate'))
+        outputs['bloom~{}.dat'.format(platform)] = data
+        print("Bloom filter for {}: {} bytes, {:.1%} false positives".format(platform, len(data), rate))
+
+    backends = dictionary_backend or {}
+    for backend in backends.values():
+        if backend not in ('elias_fano', 'perfect_hash'):
+            raise ValueError("unknown dictionary backend {!r}".format(backend))
+    outputs['perfect_hash.dat'] = perfect_hash.disabled()
+    if 'perfect_hash' in backends.values():
+        # Searching for the hash takes several seconds, so only redo it when its inputs change.
+        hash_path = os.path.join(out_dir, 'perfect_hash_full.dat')
+        if not _is_up_to_date(hash_path, [acceptable_path, perfect_hash.__file__]):
+            outputs['perfect_hash_full.dat'] = perfect_hash.encode(acceptable)
+        else:
+            outputs['perfect_hash_full.dat'] = _read(hash_path)
+        hash_data = outputs['perfect_hash_full.dat']
+    for platform, backend in sorted(backends.items()):
+        if backend == 'perfect_hash':
+            outputs['perfect_hash~{}.dat'.format(platform)] = hash_data
+        else:
+            outputs['perfect_hash~{}.dat'.format(platform)] = perfect_hash.disabled()
+    for platform, enabled in sorted((solution_index_enabled or {}).items()):
+        data = outputs['solution_index.dat'] if enabled else solution_index.disabled(solutions)
+        outputs['solution_index~{}.dat'.format(platform)] = data
+    for name, data in outputs.items():
+        if _write_if_changed(os.path.join(out_dir, name), data):
+            print("Generated {} ({} bytes)".format(name, len(data)))
+
+
+if __name__ == '__main__':
+    here = os.path.dirname(os.path.abspath(__file__))
+    generate(sys.argv[1] if len(sys.argv) > 1 else os.path.join(here, '..', 'resources'))
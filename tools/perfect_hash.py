@@ -0,0 +1,108 @@
+"""
+Builds a minimal perfect hash over the accepted word ranks, so that checking a guess costs
+one hash and a single read of the slot it lands in.
+
+This is hash-and-displace in the style of PTHash: ranks are split into buckets, and each
+bucket gets a 16-bit seed that sends all of its ranks to distinct free slots. Buckets are
+skewed (60% of the ranks go to 30% of the buckets) and placed largest first, which keeps
+the seeds small enough to find quickly even with no spare slots.
+
+Layout (little-endian):
+
+    uint16 word_count       0 if the hash is disabled for this platform
+    uint16 bucket_count
+    uint16 dense_buckets    buckets [0, dense_buckets) take the dense share of the ranks
+    uint16 dense_threshold  a rank is dense if the low half of its bucket hash is below this
+    uint16 salt             bucket hashes use seed 0x10000 + salt
+    uint16 seeds[bucket_count]
+    uint24 slots[word_count]  the rank stored in each slot
+
+A rank's bucket hash is h = hash(rank, 0x10000 + salt). If (h & 0xFFFF) < dense_threshold
+its bucket is (h >> 16) % dense_buckets, otherwise it is dense_buckets + (h >> 16) %
+(bucket_count - dense_buckets). Its slot is hash(rank, seeds[bucket]) % word_count. Slots
+hold full ranks rather than short fingerprints, so a lookup never accepts a bad word.
+This must match prv_perfect_hash_bucket() and prv_perfect_hash_contains() in src/c/dictionary.c.
+"""
+import struct
+
+from wordlist import sorted_ranks
+
+HEADER_FORMAT = '<HHHHH'
+WORDS_PER_BUCKET = 6
+DENSE_KEY_SHARE = 0.6
+DENSE_BUCKET_SHARE = 0.3
+MAX_SEED = 0xFFFF
+MAX_SALT = 0xFFFF
+
+
+def fmix32(x):
+    x ^= x >> 16
+    x = (x * 0x85EBCA6B) & 0xFFFFFFFF
+    x ^= x >> 13
+    x = (x * 0xC2B2AE35) & 0xFFFFFFFF
+    x ^= x >> 16
+    return x
+
+
+def hash_rank(rank, seed):
+    return fmix32(rank ^ ((seed * 0x9E3779B9) & 0xFFFFFFFF))
+
+
+def bucket_for(rank, salt, bucket_count, dense_buckets, dense_threshold):
+    h = hash_rank(rank, 0x10000 + salt)
+    if (h & 0xFFFF) < dense_threshold:
+        return (h >> 16) % dense_buckets
+    return dense_buckets + (h >> 16) % (bucket_count - dense_buckets)
+
+
+def disabled():
+    return struct.pack(HEADER_FORMAT, 0, 0, 0, 0, 0)
+
+
+def _place(ranks, salt, bucket_count, dense_buckets, dense_threshold):
+    count = len(ranks)
+    buckets = [[] for _ in range(bucket_count)]
+    for rank in ranks:
+        buckets[bucket_for(rank, salt, bucket_count, dense_buckets, dense_threshold)].append(rank)
+
+    slots = [None] * count
+    seeds = [0] * bucket_count
+    for b in sorted(range(bucket_count), key=lambda b: -len(buckets[b])):
+        keys = buckets[b]
+        if not keys:
+            break
+        for seed in range(MAX_SEED + 1):
+            positions = [hash_rank(rank, seed) % count for rank in keys]
+            if any(slots[p] is not None for p in positions) or len(set(positions)) != len(positions):
+                continue
+            for p, rank in zip(positions, keys):
+                slots[p] = rank
+            seeds[b] = seed
+            break
+        else:
+            return None
+    return seeds, slots
+
+
+def encode(words):
+    ranks = sorted_ranks(words)
+    count = len(ranks)
+    if count == 0 or count > 0xFFFF:
+        raise ValueError("word list size unsuitable for the perfect hash resource format")
+    bucket_count = (count + WORDS_PER_BUCKET - 1) // WORDS_PER_BUCKET
+    dense_buckets = max(1, int(bucket_count * DENSE_BUCKET_SHARE))
+    dense_threshold = int(0x10000 * DENSE_KEY_SHARE)
+
+    # A different salt reshuffles the buckets, in case some bucket can't be placed.
+    for salt in range(MAX_SALT + 1):
+        placed = _place(ranks, salt, bucket_count, dense_buckets, dense_threshold)
+        if placed is not None:
+            break
+    else:
+        raise ValueError("couldn't find a perfect hash for the word list")
+    seeds, slots = placed
+
+    header = struct.pack(HEADER_FORMAT, count, bucket_count, dense_buckets, dense_threshold, salt)
+    table = struct.pack('<{}H'.format(bucket_count), *seeds)
+    body = b''.join(struct.pack('<I', rank)[:3] for rank in slots)
+    return header + table + body
@@ -0,0 +1,28 @@
+"""
+Counts the acceptable words under each one- and two-letter prefix, for predictive letter
+input. These are the two levels of the word trie with the widest fan-out; below them a
+prefix's words are a single run of the sorted Elias-Fano list (tools/elias_fano.py), which
+is short enough to walk, so the deeper levels aren't stored at all.
+
+Layout (little-endian):
+
+    uint16 first[26]        words starting with each letter
+    uint16 second[26][26]   words starting with each two-letter prefix
+
+This must match src/c/dictionary.c.
+"""
+import struct
+
+from wordlist import ALPHABET_SIZE, PREFIX_COUNT, PREFIX_SPAN, sorted_ranks
+
+
+def encode(words):
+    first = [0] * ALPHABET_SIZE
+    second = [0] * PREFIX_COUNT
+    for rank in sorted_ranks(words):
+        prefix = rank // PREFIX_SPAN
+        first[prefix // ALPHABET_SIZE] += 1
+        second[prefix] += 1
+    if max(first) > 0xFFFF:
+        raise ValueError("word list too large for the prefix count format")
+    return struct.pack('<{}H'.format(ALPHABET_SIZE + PREFIX_COUNT), *(first + second))
@@ -0,0 +1,57 @@
+"""
+Builds bitset indexes over the solution list, so that the words still consistent with a
+guess can be found with AND/ANDNOT over whole bitsets instead of rescoring every word.
+
+Each bitset has one bit per solution, in solutions.dat order (bit i is bit i % 8 of byte
+i / 8), padded to a whole number of 32-bit words.
+
+Layout (little-endian):
+
+    uint16 solution_count
+    uint8  bitset_bytes / 4
+    uint8  max_repeats                 most times any letter appears in one solution
+    bitset at[WORD_LENGTH][26]         solution has the letter at that position
+    bitset at_least[max_repeats][26]   solution has at least k + 1 of the letter
+
+A platform that can't spare the space gets disabled() instead: the header alone, with
+max_repeats 0, which tells the reader to rescore solutions.dat against each guess.
+
+This must match src/c/candidate_tracker.c.
+"""
+import struct
+
+from wordlist import ALPHABET_SIZE, WORD_LENGTH
+
+HEADER_FORMAT = '<HBB'
+
+
+def _words_per_bitset(words):
+    count = len(words)
+    words_per_bitset = (count + 31) // 32
+    if count > 0xFFFF or words_per_bitset > 0xFF:
+        raise ValueError("solution list too large for the solution index format")
+    return words_per_bitset
+
+
+def disabled(words):
+    return struct.pack(HEADER_FORMAT, len(words), _words_per_bitset(words), 0)
+
+
+def encode(words):
+    count = len(words)
+    words_per_bitset = _words_per_bitset(words)
+    bitset_bytes = words_per_bitset * 4
+    max_repeats = max(max(word.count(c) for c in word) for word in words)
+
+    at = [[bytearray(bitset_bytes) for _ in range(ALPHABET_SIZE)] for _ in range(WORD_LENGTH)]
+    at_least = [[bytearray(bitset_bytes) for _ in range(ALPHABET_SIZE)] for _ in range(max_repeats)]
+    for i, word in enumerate(words):
+        byte, bit = i >> 3, 1 << (i & 7)
+        for position, c in enumerate(word):
+            at[position][ord(c) - ord('a')][byte] |= bit
+        for c in set(word):
+            for k in range(word.count(c)):
+                at_least[k][ord(c) - ord('a')][byte] |= bit
+
+    header = struct.pack(HEADER_FORMAT, count, words_per_bitset, max_repeats)
+    return header + b''.join(bytes(b) for table in (at, at_least) for row in table for b in row)
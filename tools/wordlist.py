@@ -0,0 +1,35 @@
+"""
+Helpers shared by the resource generators for reading the raw word lists.
+"""
+
+WORD_LENGTH = 5
+ALPHABET_SIZE = 26
+# Number of distinct ranks sharing the same two-letter prefix.
+PREFIX_SPAN = ALPHABET_SIZE ** (WORD_LENGTH - 2)
+PREFIX_COUNT = ALPHABET_SIZE ** 2
+RANK_LIMIT = ALPHABET_SIZE ** WORD_LENGTH
+
+
+def read_words(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    if len(data) % WORD_LENGTH != 0:
+        raise ValueError("{} is not a whole number of words".format(path))
+    return [data[i:i + WORD_LENGTH].decode('ascii') for i in range(0, len(data), WORD_LENGTH)]
+
+
+def word_rank(word):
+    """Maps a word to its base-26 rank, so that 'aaaaa' is 0 and 'zzzzz' is 26^5 - 1."""
+    rank = 0
+    for c in word:
+        if not 'a' <= c <= 'z':
+            raise ValueError("{!r} is not a lowercase word".format(word))
+        rank = rank * ALPHABET_SIZE + (ord(c) - ord('a'))
+    return rank
+
+
+def sorted_ranks(words):
+    ranks = [word_rank(w) for w in words]
+    if ranks != sorted(ranks) or len(set(ranks)) != len(ranks):
+        raise ValueError("word list must be sorted and free of duplicates")
+    return ranks